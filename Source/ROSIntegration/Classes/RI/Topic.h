@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <memory>
+#include <bson.h>
 #include <CoreMinimal.h>
 #include <UObject/ObjectMacros.h>
 #include <UObject/Object.h>
@@ -10,6 +11,9 @@
 
 #include "Topic.generated.h"
 
+class ROSBridgePublishMsg;
+class FBSONTemplateWriter;
+
 /**
 * @ingroup ROS Message Types
 * Which Message type to work with.
@@ -21,6 +25,34 @@ enum class EMessageType : uint8
 	Float32 = 1,
 };
 
+/**
+* @ingroup ROS Message Types
+* Scheduling class of outgoing messages on a topic.
+* Queued messages of a higher class are sent before those of lower classes,
+* e.g. /clock or /tf (Control) are not held back by queued camera images (Bulk).
+*/
+UENUM(BlueprintType, Category = "ROS")
+enum class ETopicPriority : uint8
+{
+	Bulk = 0,
+	Normal = 1,
+	Control = 2,
+};
+
+/**
+* @ingroup ROS Message Types
+* How a subscription buffers incoming messages until its callback has processed them.
+* With KeepLatest, a callback that is slower than the publisher always gets the freshest message.
+*/
+UENUM(BlueprintType, Category = "ROS")
+enum class ETopicQueuePolicy : uint8
+{
+	None = 0,		// the callback runs directly on the dispatcher worker thread of the topic
+	DropOldest = 1,	// queue up to QueueSize messages, drop the oldest one when the queue is full
+	KeepLatest = 2,	// only keep the latest message
+	Block = 3,		// queue up to QueueSize messages, hold up receiving this topic when the queue is full
+};
+
 UCLASS(Blueprintable)
 class ROSINTEGRATION_API UTopic: public UObject
 {
@@ -28,7 +60,7 @@ class ROSINTEGRATION_API UTopic: public UObject
 
 public:
 
-	bool Subscribe(std::function<void(TSharedPtr<FROSBaseMsg>)> func);
+	bool Subscribe(std::function<void(TSharedPtr<FROSBaseMsg>)> func, ETopicQueuePolicy QueuePolicy = ETopicQueuePolicy::None);
 
 	bool Unsubscribe();
 
@@ -38,9 +70,21 @@ public:
 
 	bool Publish(TSharedPtr<FROSBaseMsg> msg);
 
+	// Interface of TTypedTopic, which decodes and encodes the messages itself.
+	// The callback gets the incoming rosbridge message instead of a converted FROSBaseMsg.
+	bool SubscribeEncoded(std::function<void(const ROSBridgePublishMsg&)> func, ETopicQueuePolicy QueuePolicy = ETopicQueuePolicy::None);
+
+	// AppendFields and WriteValues take the place of the converter, see FBSONMessageTemplate
+	bool PublishEncoded(TFunctionRef<bool(bson_t*)> AppendFields, TFunctionRef<bool(FBSONTemplateWriter&)> WriteValues);
+
+	// For messages without a fixed layout, AppendFields appends every message directly
+	bool PublishEncoded(TFunctionRef<bool(bson_t*)> AppendFields);
+
 	void BeginDestroy() override;
 
-	void Init(UROSIntegrationCore *Ric, FString Topic, FString MessageType, int32 QueueSize = 10);
+	// QueueSize limits the outgoing messages that wait to be sent, the oldest one is dropped when it is full.
+	// 0 allows up to 1024 messages, which used to be unbounded.
+	void Init(UROSIntegrationCore *Ric, FString Topic, FString MessageType, int32 QueueSize = 10, ETopicPriority Priority = ETopicPriority::Normal, bool bLatch = false);
 
 	virtual void PostInitProperties() override;
 
@@ -78,7 +122,7 @@ private:
 
 
 	UFUNCTION(BlueprintCallable, Category = "ROS|Topic")
-	void Init(const FString& TopicName, EMessageType MessageType, int32 QueueSize = 1);
+	void Init(const FString& TopicName, EMessageType MessageType, int32 QueueSize = 1, ETopicPriority Priority = ETopicPriority::Normal);
 
 	/**
 	 * Subscribe to the given topic
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <CoreMinimal.h>
+#include "RI/Topic.h"
+#include "ROSMessageCodec.h"
+
+/**
+ * @ingroup ROS Message Types
+ * Topic of a message type that is known at compile time, e.g. TTypedTopic<ROSMessages::sensor_msgs::Imu>.
+ * The messages are decoded and encoded by TROSMessageCodec<MsgT> instead of a converter that is looked up at runtime:
+ * - incoming messages are decoded into an instance that the subscription reuses and passed to the callback as const MsgT&,
+ *   which is only valid during the callback. No FROSBaseMsg is allocated and no StaticCastSharedPtr is needed.
+ *   The instances start as copies of the Prototype of Subscribe(), which selects options of the message type,
+ *   e.g. an OccupancyGrid with int8_storage.
+ * - outgoing messages are encoded from const MsgT& without a TSharedPtr.
+ * The UTopic is owned by the caller, who keeps it alive, e.g. as UPROPERTY. Reconnecting works like for UTopic.
+ */
+template<class MsgT>
+class TTypedTopic
+{
+public:
+	typedef TROSMessageCodec<MsgT> FCodec;
+
+	explicit TTypedTopic(UTopic* Topic = nullptr)
+	: Topic(Topic)
+	{
+	}
+
+	void SetTopic(UTopic* InTopic) { Topic = InTopic; }
+	UTopic* GetTopic() const { return Topic; }
+
+	void Init(UROSIntegrationCore* Ric, const FString& TopicName, int32 QueueSize = 10, ETopicPriority Priority = ETopicPriority::Normal, bool bLatch = false)
+	{
+		check(Topic);
+		Topic->Init(Ric, TopicName, FCodec::MessageType(), QueueSize, Priority, bLatch);
+	}
+
+	bool Subscribe(std::function<void(const MsgT&)> Callback, ETopicQueuePolicy QueuePolicy = ETopicQueuePolicy::None, const MsgT& Prototype = MsgT())
+	{
+		check(Topic);
+		std::shared_ptr<FDecodedMessage> Decoded = std::make_shared<FDecodedMessage>(Prototype);
+		return Topic->SubscribeEncoded([Decoded, Callback](const ROSBridgePublishMsg& message) {
+			// a callback that overlaps with the previous one, e.g. right after reconnecting, decodes into its own instance
+			if (Decoded->bInUse.exchange(true)) {
+				MsgT Msg(Decoded->Prototype);
+				DecodeAndCall(message, Msg, Callback);
+				return;
+			}
+			DecodeAndCall(message, Decoded->Msg, Callback);
+			Decoded->bInUse = false;
+		}, QueuePolicy);
+	}
+
+	bool Unsubscribe()
+	{
+		return Topic && Topic->Unsubscribe();
+	}
+
+	bool Advertise()
+	{
+		return Topic && Topic->Advertise();
+	}
+
+	bool Unadvertise()
+	{
+		return Topic && Topic->Unadvertise();
+	}
+
+	bool Publish(const MsgT& Msg)
+	{
+		check(Topic);
+		if (!FCodec::bSupportsTemplate)
+		{
+			return Topic->PublishEncoded([&Msg](bson_t* message) { return FCodec::Append(Msg, message); });
+		}
+		return Topic->PublishEncoded(
+			[&Msg](bson_t* message) { return FCodec::Append(Msg, message); },
+			[&Msg](FBSONTemplateWriter& Writer) { return FCodec::WriteTemplateValues(Msg, Writer); });
+	}
+
+private:
+	struct FDecodedMessage
+	{
+		explicit FDecodedMessage(const MsgT& Prototype)
+		: Prototype(Prototype)
+		, Msg(Prototype)
+		{
+		}
+
+		const MsgT Prototype;
+		MsgT Msg;
+		std::atomic<bool> bInUse{ false };
+	};
+
+	static void DecodeAndCall(const ROSBridgePublishMsg& message, MsgT& Msg, const std::function<void(const MsgT&)>& Callback)
+	{
+		if (FCodec::Decode(message, Msg)) {
+			Callback(Msg);
+		}
+		else {
+			UE_LOG(LogROS, Error, TEXT("Couldn't convert incoming Message; Skipping callback"));
+		}
+	}
+
+	UTopic* Topic;
+};
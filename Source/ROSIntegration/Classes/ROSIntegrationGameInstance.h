@@ -46,6 +46,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS")
 	bool bCheckHealth = true;
 
+	// Publishes the transforms of all UTFBroadcastComponents on /tf, created on first use and initialized once ROSIntegrationCore exists
+	class UTFAggregator* GetTFAggregator();
+
+	// Buffers the transforms received on /tf and /tf_static for lookups, created on first use and initialized once ROSIntegrationCore exists
+	class UTFBuffer* GetTFBuffer();
+
 protected:
 	void CheckROSBridgeHealth();
 
@@ -66,6 +72,12 @@ private:
 
 	UPROPERTY()
 	class UTopic* ClockTopic = nullptr;
+
+	UPROPERTY()
+	class UTFAggregator* TFAggregator = nullptr;
+
+	UPROPERTY()
+	class UTFBuffer* TFBuffer = nullptr;
 };
 
 
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Tickable.h>
+#include <UObject/ObjectMacros.h>
+#include <UObject/Object.h>
+#include "RI/Topic.h"
+
+#include "TFAggregator.generated.h"
+
+class UTFBroadcastComponent;
+
+/**
+ * Publishes the transforms of all UTFBroadcastComponents of a world in a single tf2_msgs/TFMessage per frame,
+ * instead of a message per component.
+ * Static components are published on the latched /tf_static topic whenever one of them changes. Since a latched
+ * topic only keeps its last message, every message on /tf_static holds the transforms of all static components.
+ * It ticks after the actors of the world, so every transform is collected once their movement has been applied.
+ * Use UROSIntegrationGameInstance::GetTFAggregator() to get the aggregator of a game. It follows the world of the
+ * last registered component, so it keeps publishing after a new level has been loaded.
+ */
+UCLASS()
+class ROSINTEGRATION_API UTFAggregator : public UObject, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	void Init(UROSIntegrationCore* ROSIntegrationCore, UWorld* World);
+	bool IsInitialized() const { return _TFTopic != nullptr; }
+
+	void Register(UTFBroadcastComponent* Component);
+	void Unregister(UTFBroadcastComponent* Component);
+
+	// Publishes the static transforms again on the next tick, e.g. after reconnecting to rosbridge
+	void RepublishStaticTransforms() { bStaticTransformsDirty = StaticComponents.Num() > 0; }
+
+	int32 NumRegisteredComponents() const { return Components.Num() + StaticComponents.Num(); }
+
+	// Number of transforms in the last message on /tf
+	int32 NumPublishedTransforms() const { return PublishedTransforms; }
+
+	// Number of transforms that have been skipped by the dead band of their component, in the last frame and in total
+	int32 NumSuppressedTransforms() const { return SuppressedTransforms; }
+	int64 NumTotalSuppressedTransforms() const { return TotalSuppressedTransforms; }
+
+	// Number of messages that have been published on /tf_static
+	int32 NumStaticPublishes() const { return StaticPublishes; }
+
+	void Tick(float DeltaTime) override;
+	bool IsTickable() const override;
+	bool IsTickableInEditor() const override;
+	bool IsTickableWhenPaused() const override;
+	TStatId GetStatId() const override;
+
+	UWorld* GetWorld() const override;
+
+private:
+	void PublishStaticTransforms();
+
+	UPROPERTY()
+	UTopic* _TFTopic = nullptr;
+
+	UPROPERTY()
+	UTopic* _TFStaticTopic = nullptr;
+
+	TWeakObjectPtr<UWorld> _World;
+
+	// Not a UPROPERTY, destroyed components are dropped on the next tick
+	TArray<TWeakObjectPtr<UTFBroadcastComponent>> Components;
+	TArray<TWeakObjectPtr<UTFBroadcastComponent>> StaticComponents;
+
+	// /tf_static has to be republished, e.g. a static component has been added, removed or moved.
+	// Stays set until publishing succeeds.
+	bool bStaticTransformsDirty = false;
+
+	int32 PublishedTransforms = 0;
+	int32 SuppressedTransforms = 0;
+	int64 TotalSuppressedTransforms = 0;
+	int32 StaticPublishes = 0;
+};
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <Components/ActorComponent.h>
-#include "RI/Topic.h"
+#include "ROSTime.h"
+#include "geometry_msgs/TransformStamped.h"
 
 #include "TFBroadcastComponent.generated.h"
 
@@ -22,11 +23,26 @@ public:
 	// Sets default values for this component's properties
 	UTFBroadcastComponent();
 
-	// Called when the game starts
+	// Called when the game starts, registers this component with the UTFAggregator of the game
 	virtual void BeginPlay() override;
 
-	// Called every frame
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Called by UTFAggregator once per frame.
+	// Appends the transform of this frame to Transforms when it is due according to FrameRate.
+	// Returns true if the transform was due, but has been skipped because it stayed within the dead band.
+	bool CollectTransform(float DeltaTime, const FROSTime& Time, TArray<ROSMessages::geometry_msgs::TransformStamped>& Transforms);
+
+	// Called by UTFAggregator once per frame for static components.
+	// Checks the transform at FrameRate and returns true if it has to be republished on /tf_static.
+	bool UpdateStaticTransform(float DeltaTime, const FROSTime& Time);
+
+	// The transform that has last been published on /tf_static
+	const ROSMessages::geometry_msgs::TransformStamped& GetStaticTransform() const { return StaticTransform; }
+	bool HasStaticTransform() const { return bHasStaticTransform; }
+
+	// Number of transforms that have been skipped because they stayed within the dead band
+	int32 GetSuppressedPublishes() const { return SuppressedPublishes; }
 
 	// Activate this Component by setting this flag to TRUE
 	UPROPERTY(EditAnywhere, Category="TFBroadcastComponent")
@@ -36,6 +52,33 @@ public:
 	UPROPERTY(EditAnywhere, Category="TFBroadcastComponent")
 	uint32 FrameRate;
 
+	// Publish this frame on the latched /tf_static topic, e.g. for mounted sensors.
+	// The transform is published once and then only if it moves by more than the tolerances,
+	// which are checked at FrameRate. Set it before BeginPlay.
+	UPROPERTY(EditAnywhere, Category="TFBroadcastComponent")
+	bool bStatic = false;
+
+	// Translation (in m) that a static frame has to move to be republished
+	UPROPERTY(EditAnywhere, Category="TFBroadcastComponent", meta = (EditCondition = "bStatic"))
+	float StaticTranslationTolerance = 0.001f;
+
+	// Rotation (in rad) that a static frame has to turn to be republished
+	UPROPERTY(EditAnywhere, Category="TFBroadcastComponent", meta = (EditCondition = "bStatic"))
+	float StaticRotationTolerance = 0.001f;
+
+	// Skip publishing this frame on /tf while it moves less than DeadBandTranslation (in m) and turns less than
+	// DeadBandRotation (in rad) relative to the transform that has last been published, e.g. for parked vehicles.
+	// The dead band is disabled if both are 0.
+	UPROPERTY(EditAnywhere, Category="TFBroadcastComponent", meta = (EditCondition = "!bStatic"))
+	float DeadBandTranslation = 0.f;
+
+	UPROPERTY(EditAnywhere, Category="TFBroadcastComponent", meta = (EditCondition = "!bStatic"))
+	float DeadBandRotation = 0.f;
+
+	// Frames within the dead band are still published after this many seconds, so tf listeners don't drop them
+	UPROPERTY(EditAnywhere, Category="TFBroadcastComponent", meta = (EditCondition = "!bStatic"))
+	float KeepAliveInterval = 1.f;
+
 	// Sets wether the coordinates of this actor shall be published in world coordinates or relative to the owning Actor
 	// If you set 'relative' here, please make sure that the actor of this component has a parent actor.
 	UPROPERTY(EditAnywhere, Category="TFBroadcastComponent")
@@ -64,12 +107,32 @@ public:
 
 	void SetFramerate(const float _FrameRate);
 
-	UPROPERTY()
-	UTopic *_TFTopic;
-
 	// Returns null if no parent has been found
 	AActor *GetParentActor();
 
 private:
+	bool IsFrameDue(float DeltaTime);
+
+	// Returns false if the transform can't be determined
+	bool ComputeTransform(const FROSTime& Time, ROSMessages::geometry_msgs::TransformStamped& TransformStamped);
+
+	// Returns true if To differs from From in its frames, or by more than the tolerances in translation or rotation
+	static bool HasMoved(const ROSMessages::geometry_msgs::TransformStamped& From, const ROSMessages::geometry_msgs::TransformStamped& To,
+		float TranslationTolerance, float RotationTolerance);
+
+	bool IsDeadBandEnabled() const { return DeadBandTranslation > 0.f || DeadBandRotation > 0.f; }
+
 	uint32 TickCounter = 0;
+
+	bool bHasStaticTransform = false;
+	ROSMessages::geometry_msgs::TransformStamped StaticTransform;
+
+	// Transform that has last been published on /tf, only kept for the dead band
+	bool bHasPublishedTransform = false;
+	ROSMessages::geometry_msgs::TransformStamped PublishedTransform;
+	float TimeSincePublish = 0.f;
+	int32 SuppressedPublishes = 0;
+
+	UPROPERTY()
+	class UTFAggregator* _TFAggregator = nullptr;
 };
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/ObjectMacros.h>
+#include <UObject/Object.h>
+#include "RI/Topic.h"
+#include "ROSTime.h"
+#include "geometry_msgs/TransformStamped.h"
+
+#include "TFBuffer.generated.h"
+
+/**
+ * Buffers the transforms received on /tf and /tf_static and resolves transforms between arbitrary frames,
+ * like a tf2 buffer. Every frame keeps a ring of its last transforms to its parent, lookups interpolate
+ * between them (lerp for the translation, slerp for the rotation).
+ * The path between two frames is cached until the frame tree changes, so repeated lookups walk the path without allocating.
+ * All methods are thread-safe, the buffer is filled from the rosbridge thread.
+ * Use UROSIntegrationGameInstance::GetTFBuffer() to get the buffer of a game.
+ */
+UCLASS()
+class ROSINTEGRATION_API UTFBuffer : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Subscribes to /tf and /tf_static. Every frame keeps up to SamplesPerFrame transforms.
+	void Init(UROSIntegrationCore* ROSIntegrationCore, int32 SamplesPerFrame = 256);
+	bool IsInitialized() const { return _TFTopic != nullptr; }
+
+	// Adds the transform from Transform.child_frame_id to Transform.header.frame_id.
+	// Static transforms are valid at any time. Returns false if the transform is invalid.
+	bool AddTransform(const ROSMessages::geometry_msgs::TransformStamped& Transform, bool bStatic = false);
+	void AddTransforms(const TArray<ROSMessages::geometry_msgs::TransformStamped>& Transforms, bool bStatic = false);
+
+	// Looks up the transform that maps points from SourceFrame to TargetFrame at Time. Its header.frame_id is
+	// TargetFrame and its child_frame_id is SourceFrame. A zero Time looks up the latest time at which all
+	// transforms between the frames are known.
+	// Returns false if the frames are not connected or Time is not covered by the buffered transforms.
+	bool LookupTransform(const FString& TargetFrame, const FString& SourceFrame, const FROSTime& Time,
+		ROSMessages::geometry_msgs::TransformStamped& Transform) const;
+
+	// Like above, but only returns the transform and its time, without copying the frame names.
+	// Reuse Transform for repeated lookups, the message classes allocate on construction.
+	bool LookupTransform(const FString& TargetFrame, const FString& SourceFrame, const FROSTime& Time,
+		ROSMessages::geometry_msgs::Transform& Transform, FROSTime& Stamp) const;
+
+	bool CanTransform(const FString& TargetFrame, const FString& SourceFrame, const FROSTime& Time) const;
+
+	// Names of all known frames
+	TArray<FString> GetFrames() const;
+
+	// Drops all transforms, e.g. when the simulated time jumps back
+	void Clear();
+
+	void BeginDestroy() override;
+
+private:
+	// Plain doubles, the message classes allocate their _MessageType on construction
+	struct FPose
+	{
+		double X = 0, Y = 0, Z = 0;
+		double QX = 0, QY = 0, QZ = 0, QW = 1;
+	};
+
+	struct FSample
+	{
+		int64 Stamp = 0; // ns
+		FPose Pose;
+	};
+
+	struct FFrame
+	{
+		FString Name;
+		int32 Parent = INDEX_NONE;
+		bool bStatic = false;
+
+		// ring of transforms to Parent, ordered by their stamp
+		TArray<FSample> Samples;
+		int32 First = 0;
+		int32 Num = 0;
+
+		const FSample& Sample(int32 i) const { return Samples[(First + i) % Samples.Num()]; }
+		FSample& Sample(int32 i) { return Samples[(First + i) % Samples.Num()]; }
+	};
+
+	// Frames from the source and the target up to, but not including, their common ancestor
+	struct FChain
+	{
+		uint32 Generation = 0;
+		TArray<int32> SourcePath;
+		TArray<int32> TargetPath;
+	};
+
+	void OnTFMessage(TSharedPtr<FROSBaseMsg> Msg, bool bStatic);
+
+	static FString NormalizeFrameName(const FString& Frame);
+	int32 FindFrame(const FString& Frame) const;
+	int32 FindOrAddFrame(const FString& Frame);
+
+	void InsertSample(FFrame& Frame, const FSample& Sample);
+	bool LookupPose(int32 Target, int32 Source, int64& Stamp, FPose& Result) const;
+	const FChain* FindChain(int32 Target, int32 Source) const;
+	bool GetLatestCommonStamp(const FChain& Chain, int64& Stamp) const;
+	bool InterpolateFrame(const FFrame& Frame, int64 Stamp, FPose& Result) const;
+
+	// Pose that applies B, then A
+	static FPose Compose(const FPose& A, const FPose& B);
+	static FPose Inverse(const FPose& Pose);
+	// Lerp of the translation, slerp of the rotation
+	static FPose Interpolate(const FPose& A, const FPose& B, double Alpha);
+
+	UPROPERTY()
+	UTopic* _TFTopic = nullptr;
+
+	UPROPERTY()
+	UTopic* _TFStaticTopic = nullptr;
+
+	int32 SamplesPerFrame = 256;
+
+	// Frame names are case-sensitive in ROS, the default FString keys are not
+	struct FFrameNameKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+	{
+		static bool Matches(KeyInitType A, KeyInitType B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(KeyInitType Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	mutable FCriticalSection Mutex;
+	TArray<FFrame> Frames;
+	TMap<FString, int32, FDefaultSetAllocator, FFrameNameKeyFuncs> FrameIndices;
+
+	// Chains by target << 32 | source, only valid for the Generation of the frame tree they have been resolved in.
+	// They are dropped when the frame tree changes, or when there are too many of them.
+	mutable TMap<uint64, FChain> Chains;
+	mutable uint32 ChainsGeneration = 0;
+	uint32 Generation = 1;
+};
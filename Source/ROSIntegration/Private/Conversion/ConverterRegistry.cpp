@@ -0,0 +1,101 @@
+#include "Conversion/ConverterRegistry.h"
+
+#include <UObject/UObjectIterator.h>
+#include "Conversion/Messages/BaseMessageConverter.h"
+#include "Conversion/Services/BaseRequestConverter.h"
+#include "Conversion/Services/BaseResponseConverter.h"
+
+FConverterRegistry& FConverterRegistry::Get()
+{
+	static FConverterRegistry Registry;
+	return Registry;
+}
+
+void FConverterRegistry::Build()
+{
+	FTablesPtr Built = BuildTables();
+
+	FScopeLock Lock(&Mutex);
+	Tables = Built;
+	bStale = false;
+}
+
+void FConverterRegistry::Invalidate()
+{
+	FScopeLock Lock(&Mutex);
+	bStale = true;
+}
+
+template<class T>
+T* FConverterRegistry::Find(FName Type, TMap<FName, T*> FTables::*Converters)
+{
+	FTablesPtr Current;
+	{
+		FScopeLock Lock(&Mutex);
+		if (!Tables.IsValid()) {
+			Tables = BuildTables();
+			bStale = false;
+		}
+		Current = Tables;
+	}
+
+	if (T* const* Converter = ((*Current).*Converters).Find(Type)) {
+		return *Converter;
+	}
+
+	// the converter may belong to a module that has been loaded after the tables have been built
+	FScopeLock Lock(&Mutex);
+	if (bStale) {
+		Tables = BuildTables();
+		bStale = false;
+		if (T* const* Converter = ((*Tables).*Converters).Find(Type)) {
+			return *Converter;
+		}
+	}
+	return nullptr;
+}
+
+UBaseMessageConverter* FConverterRegistry::FindMessageConverter(FName MessageType)
+{
+	return Find(MessageType, &FTables::MessageConverters);
+}
+
+UBaseRequestConverter* FConverterRegistry::FindRequestConverter(FName ServiceType)
+{
+	return Find(ServiceType, &FTables::RequestConverters);
+}
+
+UBaseResponseConverter* FConverterRegistry::FindResponseConverter(FName ServiceType)
+{
+	return Find(ServiceType, &FTables::ResponseConverters);
+}
+
+FConverterRegistry::FTablesPtr FConverterRegistry::BuildTables()
+{
+	TSharedPtr<FTables, ESPMode::ThreadSafe> Built(new FTables());
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* ClassItr = *It;
+
+		if (ClassItr->IsChildOf(UBaseMessageConverter::StaticClass()) && ClassItr != UBaseMessageConverter::StaticClass())
+		{
+			UBaseMessageConverter* ConcreteConverter = ClassItr->GetDefaultObject<UBaseMessageConverter>();
+			UE_LOG(LogROS, Verbose, TEXT("Added %s with type %s to the message converters"), *(ClassItr->GetDefaultObjectName().ToString()), *(ConcreteConverter->_MessageType));
+			Built->MessageConverters.Add(FName(*ConcreteConverter->_MessageType), ConcreteConverter);
+		}
+		else if (ClassItr->IsChildOf(UBaseRequestConverter::StaticClass()) && ClassItr != UBaseRequestConverter::StaticClass())
+		{
+			UBaseRequestConverter* ConcreteConverter = ClassItr->GetDefaultObject<UBaseRequestConverter>();
+			UE_LOG(LogROS, Verbose, TEXT("Added %s with type %s to the request converters"), *(ClassItr->GetDefaultObjectName().ToString()), *(ConcreteConverter->_ServiceType));
+			Built->RequestConverters.Add(FName(*ConcreteConverter->_ServiceType), ConcreteConverter);
+		}
+		else if (ClassItr->IsChildOf(UBaseResponseConverter::StaticClass()) && ClassItr != UBaseResponseConverter::StaticClass())
+		{
+			UBaseResponseConverter* ConcreteConverter = ClassItr->GetDefaultObject<UBaseResponseConverter>();
+			UE_LOG(LogROS, Verbose, TEXT("Added %s with type %s to the response converters"), *(ClassItr->GetDefaultObjectName().ToString()), *(ConcreteConverter->_ServiceType));
+			Built->ResponseConverters.Add(FName(*ConcreteConverter->_ServiceType), ConcreteConverter);
+		}
+	}
+	return Built;
+}
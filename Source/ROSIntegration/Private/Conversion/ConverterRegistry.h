@@ -0,0 +1,53 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/NameTypes.h>
+
+class UBaseMessageConverter;
+class UBaseRequestConverter;
+class UBaseResponseConverter;
+
+/**
+ * Converters of all message and service types by their interned type name.
+ * The converter classes are collected once when the module starts up instead of scanning every loaded class
+ * on the first UTopic::Init and UService::Init.
+ * Every build produces an immutable set of tables, lookups only take the lock to grab the current one.
+ * Converters of modules loaded after the startup, e.g. of the game module, are collected by the first lookup
+ * that misses after such a module has been loaded.
+ * Building the tables creates the default objects of the converters and has to happen on the game thread.
+ */
+class FConverterRegistry
+{
+public:
+	static FConverterRegistry& Get();
+
+	// Collects the converters of all loaded classes
+	void Build();
+
+	// Marks the tables as incomplete, e.g. when another module has been loaded
+	void Invalidate();
+
+	// Return nullptr if there is no converter for the type
+	UBaseMessageConverter* FindMessageConverter(FName MessageType);
+	UBaseRequestConverter* FindRequestConverter(FName ServiceType);
+	UBaseResponseConverter* FindResponseConverter(FName ServiceType);
+
+private:
+	struct FTables
+	{
+		TMap<FName, UBaseMessageConverter*> MessageConverters;
+		TMap<FName, UBaseRequestConverter*> RequestConverters;
+		TMap<FName, UBaseResponseConverter*> ResponseConverters;
+	};
+	typedef TSharedPtr<const FTables, ESPMode::ThreadSafe> FTablesPtr;
+
+	static FTablesPtr BuildTables();
+
+	// Looks up Type in the tables, rebuilds them once if Type is missing and they are stale
+	template<class T>
+	T* Find(FName Type, TMap<FName, T*> FTables::*Converters);
+
+	FCriticalSection Mutex;
+	FTablesPtr Tables;
+	bool bStale = true;
+};
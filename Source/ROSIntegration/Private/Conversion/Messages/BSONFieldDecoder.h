@@ -0,0 +1,318 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "ROSIntegrationCore.h"
+#include "ROSTime.h"
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <bson.h>
+
+// Reads single bson values into the field types of the message structs.
+// The bson types are checked like in rosbridge2cpp::Helper, e.g. a double field must hold a bson double.
+struct FBSONValueReader
+{
+	static bool Read(const bson_iter_t& Iter, double& Value)
+	{
+		if (!BSON_ITER_HOLDS_DOUBLE(&Iter)) return false;
+		Value = bson_iter_double(&Iter);
+		return true;
+	}
+
+	// bson doesn't support float, only double
+	static bool Read(const bson_iter_t& Iter, float& Value)
+	{
+		if (!BSON_ITER_HOLDS_DOUBLE(&Iter)) return false;
+		Value = (float)bson_iter_double(&Iter);
+		return true;
+	}
+
+	static bool Read(const bson_iter_t& Iter, bool& Value)
+	{
+		if (!BSON_ITER_HOLDS_BOOL(&Iter)) return false;
+		Value = bson_iter_bool(&Iter);
+		return true;
+	}
+
+	// All integer fields and enums are sent as int32 (there is no uint32 in bson)
+	template<class T>
+	static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, bool>::type Read(const bson_iter_t& Iter, T& Value)
+	{
+		if (!BSON_ITER_HOLDS_INT32(&Iter)) return false;
+		Value = static_cast<T>(bson_iter_int32(&Iter));
+		return true;
+	}
+
+	static bool Read(const bson_iter_t& Iter, FString& Value)
+	{
+		if (!BSON_ITER_HOLDS_UTF8(&Iter)) return false;
+		Value = UTF8_TO_TCHAR(bson_iter_utf8(&Iter, nullptr));
+		return true;
+	}
+
+	// Points into the bson, which has to outlive the message
+	static bool Read(const bson_iter_t& Iter, const uint8*& Value)
+	{
+		uint32_t Length = 0;
+		return ReadBinary(Iter, Value, Length);
+	}
+
+	static bool ReadBinary(const bson_iter_t& Iter, const uint8*& Value, uint32_t& Length)
+	{
+		if (!BSON_ITER_HOLDS_BINARY(&Iter)) return false;
+		bson_subtype_t Subtype;
+		bson_iter_binary(&Iter, &Subtype, &Length, &Value);
+		return true;
+	}
+
+	// ROS time, e.g. header.stamp
+	static bool Read(const bson_iter_t& Iter, FROSTime& Value)
+	{
+		bson_iter_t Child;
+		if (!BSON_ITER_HOLDS_DOCUMENT(&Iter) || !bson_iter_recurse(&Iter, &Child)) return false;
+
+		bool bSecFound = false, bNSecFound = false;
+		while (bson_iter_next(&Child)) {
+			const char* Key = bson_iter_key(&Child);
+			if (strcmp(Key, "secs") == 0 && BSON_ITER_HOLDS_INT32(&Child)) {
+				Value._Sec = bson_iter_int32(&Child);
+				bSecFound = true;
+			}
+			else if (strcmp(Key, "nsecs") == 0 && BSON_ITER_HOLDS_INT32(&Child)) {
+				Value._NSec = bson_iter_int32(&Child);
+				bNSecFound = true;
+			}
+		}
+		return bSecFound && bNSecFound;
+	}
+
+	// Number of elements of the array or document that the current element of Iter holds
+	static int32 CountElements(const bson_iter_t& Iter)
+	{
+		bson_iter_t Child;
+		if (!bson_iter_recurse(&Iter, &Child)) return 0;
+
+		int32 Num = 0;
+		while (bson_iter_next(&Child)) {
+			++Num;
+		}
+		return Num;
+	}
+
+	// Reads the elements of a bson array in one pass, ReadElement is called for every element.
+	// The elements are counted first, so Value is allocated only once.
+	template<class T, class F>
+	static bool ReadArray(const bson_iter_t& Iter, TArray<T>& Value, const F& ReadElement)
+	{
+		bson_iter_t Child;
+		if (!BSON_ITER_HOLDS_ARRAY(&Iter) || !bson_iter_recurse(&Iter, &Child)) return false;
+
+		Value.Reset(CountElements(Iter));
+		while (bson_iter_next(&Child)) {
+			if (!ReadElement(Child, Value[Value.AddDefaulted()])) return false;
+		}
+		return true;
+	}
+
+	// Reads a bson array of int32 into Value and converts the numbers to T, e.g. to int8 for an OccupancyGrid.
+	// The elements are read straight from the array document in two tight loops, the first one checks their
+	// layout and counts them, the second one copies the values. This avoids the per-element overhead of
+	// bson_iter_next for arrays with millions of elements.
+	template<class T>
+	static bool ReadInt32Array(const bson_iter_t& Iter, TArray<T>& Value)
+	{
+		if (!BSON_ITER_HOLDS_ARRAY(&Iter)) return false;
+
+		uint32_t Length = 0;
+		const uint8* Data = nullptr;
+		bson_iter_array(&Iter, &Length, &Data);
+		if (!Data || Length < 5 || Data[Length - 1] != 0) return false;
+
+		// elements are a type byte, a key with terminator and 4 bytes of value
+		const uint8* const End = Data + Length - 1;
+		int32 Num = 0;
+		for (const uint8* Element = Data + 4; Element < End; ++Num) {
+			if (*Element != BSON_TYPE_INT32) return false;
+			// keys are short decimal indices, so a plain loop beats memchr
+			const uint8* KeyEnd = Element + 1;
+			while (KeyEnd < End && *KeyEnd) ++KeyEnd;
+			if (End - KeyEnd < 5) return false;
+			Element = KeyEnd + 5;
+		}
+
+		Value.SetNumUninitialized(Num);
+		T* Out = Value.GetData();
+		for (const uint8* Element = Data + 4; Element < End; ++Out) {
+			for (++Element; *Element; ++Element) {}
+			++Element;
+			uint32 ValueLE;
+			FMemory::Memcpy(&ValueLE, Element, 4);
+			*Out = static_cast<T>((int32)BSON_UINT32_FROM_LE(ValueLE));
+			Element += 4;
+		}
+		return true;
+	}
+
+	template<class T>
+	static bool Read(const bson_iter_t& Iter, TArray<T>& Value)
+	{
+		return ReadArray(Iter, Value, [](const bson_iter_t& Element, T& ElementValue) { return Read(Element, ElementValue); });
+	}
+};
+
+/**
+ * Decodes a bson document into a message struct of type T in a single forward pass.
+ *
+ * The field table is built once per message type, usually in a function-local static of its converter:
+ *
+ *	static const auto Decoder = TBSONFieldDecoder<ROSMessages::geometry_msgs::Vector3>()
+ *		.Field("x", &ROSMessages::geometry_msgs::Vector3::x)
+ *		.Field("y", &ROSMessages::geometry_msgs::Vector3::y)
+ *		.Field("z", &ROSMessages::geometry_msgs::Vector3::z);
+ *
+ * Every key of the document is matched against the table, starting at the field after the previous match,
+ * so fields that arrive in the order of the message definition are matched with a single comparison.
+ * Unknown keys are skipped. A table holds at most 64 fields.
+ */
+template<class T>
+class TBSONFieldDecoder
+{
+public:
+	// Reads the value of a field into the message, returns false if it can't be decoded
+	typedef std::function<bool(const bson_iter_t&, T&)> FReadField;
+
+	// Adds a field with custom decoding
+	TBSONFieldDecoder& Field(const char* Name, FReadField ReadField, bool bRequired = true)
+	{
+		return AddField(Name, [ReadField](const bson_iter_t& Iter, T& Value, bool) { return ReadField(Iter, Value); }, bRequired);
+	}
+
+	// Adds a field that is read with FBSONValueReader
+	template<class M>
+	TBSONFieldDecoder& Field(const char* Name, M T::*Member, bool bRequired = true)
+	{
+		return Field(Name, [Member](const bson_iter_t& Iter, T& Value) { return FBSONValueReader::Read(Iter, Value.*Member); }, bRequired);
+	}
+
+	// Adds a field that holds a message, which is decoded with the decoder of its type
+	template<class M>
+	TBSONFieldDecoder& Field(const char* Name, M T::*Member, const TBSONFieldDecoder<M>& Decoder, bool bRequired = true)
+	{
+		const TBSONFieldDecoder<M>* ChildDecoder = &Decoder;
+		return AddField(Name, [Member, ChildDecoder](const bson_iter_t& Iter, T& Value, bool LogOnErrors) {
+			return ChildDecoder->DecodeValue(Iter, Value.*Member, LogOnErrors);
+		}, bRequired);
+	}
+
+	// Adds a field that holds an array of messages, which are decoded with the decoder of their type
+	template<class M>
+	TBSONFieldDecoder& Field(const char* Name, TArray<M> T::*Member, const TBSONFieldDecoder<M>& Decoder, bool bRequired = true)
+	{
+		const TBSONFieldDecoder<M>* ElementDecoder = &Decoder;
+		return AddField(Name, [Member, ElementDecoder](const bson_iter_t& Iter, T& Value, bool LogOnErrors) {
+			return FBSONValueReader::ReadArray(Iter, Value.*Member, [ElementDecoder, LogOnErrors](const bson_iter_t& Element, M& ElementValue) {
+				return ElementDecoder->DecodeValue(Element, ElementValue, LogOnErrors);
+			});
+		}, bRequired);
+	}
+
+	// Adds a check of the decoded message, e.g. of the size of its arrays
+	TBSONFieldDecoder& Validate(bool (*IsValid)(const T&))
+	{
+		Validation = IsValid;
+		return *this;
+	}
+
+	// Decodes the fields of the document that Iter points into, e.g. after bson_iter_recurse
+	bool Decode(bson_iter_t& Iter, T& Value, bool LogOnErrors = true) const
+	{
+		uint64 FoundFields = 0;
+		int32 NextField = 0;
+		while (bson_iter_next(&Iter)) {
+			const char* Key = bson_iter_key(&Iter);
+			const int32 Index = FindField(Key, NextField);
+			if (Index == INDEX_NONE) continue;
+
+			if (!Fields[Index].Read(Iter, Value, LogOnErrors)) {
+				if (LogOnErrors) {
+					UE_LOG(LogROS, Error, TEXT("Key %s has an unexpected type or content"), UTF8_TO_TCHAR(Key));
+				}
+				return false;
+			}
+			FoundFields |= uint64(1) << Index;
+			NextField = Index + 1 < Fields.Num() ? Index + 1 : 0;
+		}
+
+		if ((FoundFields & RequiredFields) != RequiredFields) {
+			if (LogOnErrors) {
+				for (int32 i = 0; i < Fields.Num(); ++i) {
+					if ((RequiredFields & ~FoundFields) & (uint64(1) << i)) {
+						UE_LOG(LogROS, Error, TEXT("Key %s not present in data"), UTF8_TO_TCHAR(Fields[i].Name));
+						break;
+					}
+				}
+			}
+			return false;
+		}
+
+		return !Validation || Validation(Value);
+	}
+
+	// Decodes the document that the current element of Iter holds
+	bool DecodeValue(const bson_iter_t& Iter, T& Value, bool LogOnErrors = true) const
+	{
+		bson_iter_t Child;
+		if (!BSON_ITER_HOLDS_DOCUMENT(&Iter) || !bson_iter_recurse(&Iter, &Child)) return false;
+		return Decode(Child, Value, LogOnErrors);
+	}
+
+	// Decodes the document at Key in dot notation, e.g. "msg.pose"
+	bool DecodeChild(const bson_t* Document, const char* Key, T& Value, bool LogOnErrors = true) const
+	{
+		check(Document != nullptr);
+
+		bson_iter_t Iter, Child;
+		if (!bson_iter_init(&Iter, Document) || !bson_iter_find_descendant(&Iter, Key, &Child)) {
+			if (LogOnErrors) {
+				UE_LOG(LogROS, Error, TEXT("Key %s not present in data"), UTF8_TO_TCHAR(Key));
+			}
+			return false;
+		}
+		return DecodeValue(Child, Value, LogOnErrors);
+	}
+
+private:
+	typedef std::function<bool(const bson_iter_t&, T&, bool)> FReadFieldLogged;
+
+	struct FField
+	{
+		const char* Name;
+		FReadFieldLogged Read;
+	};
+
+	TBSONFieldDecoder& AddField(const char* Name, FReadFieldLogged ReadField, bool bRequired)
+	{
+		check(Fields.Num() < 64);
+		if (bRequired) {
+			RequiredFields |= uint64(1) << Fields.Num();
+		}
+		Fields.Add({ Name, MoveTemp(ReadField) });
+		return *this;
+	}
+
+	int32 FindField(const char* Key, int32 Start) const
+	{
+		for (int32 i = Start; i < Fields.Num(); ++i) {
+			if (strcmp(Fields[i].Name, Key) == 0) return i;
+		}
+		for (int32 i = 0; i < Start; ++i) {
+			if (strcmp(Fields[i].Name, Key) == 0) return i;
+		}
+		return INDEX_NONE;
+	}
+
+	TArray<FField> Fields;
+	uint64 RequiredFields = 0;
+	bool (*Validation)(const T&) = nullptr;
+};
@@ -0,0 +1,129 @@
+#include "Conversion/Messages/BSONMessageTemplate.h"
+
+#include "Conversion/Messages/BaseMessageConverter.h"
+
+bool FBSONMessageTemplate::Append(UBaseMessageConverter* Converter, TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
+{
+	return Append(Converter->_MessageType,
+		[Converter, &BaseMsg](bson_t* Fields) { return Converter->AppendOutgoingMessage(BaseMsg, Fields); },
+		[Converter, &BaseMsg](FBSONTemplateWriter& Writer) { return Converter->WriteTemplateValues(BaseMsg, Writer); },
+		message);
+}
+
+bool FBSONMessageTemplate::Append(const FString& MessageType, TFunctionRef<bool(bson_t*)> AppendFields, TFunctionRef<bool(FBSONTemplateWriter&)> WriteValues, bson_t* message)
+{
+	FScopeLock Lock(&Mutex);
+
+	if (bDisabled) {
+		return AppendFields(message);
+	}
+
+	if (Document.Num() > 0) {
+		FBSONTemplateWriter Writer(Document.GetData(), Slots);
+		if (WriteValues(Writer) && Writer.IsComplete()) {
+			bson_t Patched;
+			return bson_init_static(&Patched, Document.GetData(), Document.Num()) && bson_concat(message, &Patched);
+		}
+		// the layout of this message differs, e.g. by a longer frame_id
+	}
+	return Encode(MessageType, AppendFields, WriteValues, message);
+}
+
+void FBSONMessageTemplate::Reset()
+{
+	FScopeLock Lock(&Mutex);
+
+	Document.Empty();
+	Slots.Empty();
+	bDisabled = false;
+}
+
+bool FBSONMessageTemplate::Encode(const FString& MessageType, TFunctionRef<bool(bson_t*)> AppendFields, TFunctionRef<bool(FBSONTemplateWriter&)> WriteValues, bson_t* message)
+{
+	Document.Reset();
+	Slots.Reset();
+
+	bson_t Encoded;
+	bson_init(&Encoded);
+	if (!AppendFields(&Encoded)) {
+		bson_destroy(&Encoded);
+		return false;
+	}
+
+	const uint8* Data = bson_get_data(&Encoded);
+	Document.Append(Data, Encoded.len);
+
+	bson_iter_t Iter;
+	const bool bHasSlots = bson_iter_init(&Iter, &Encoded) && CollectSlots(Iter, Data, Slots);
+
+	// writing the values of the same message must not change the document
+	FBSONTemplateWriter Writer(Document.GetData(), Slots, true);
+	if (!WriteValues(Writer)) {
+		bDisabled = true;
+	}
+	else if (!bHasSlots || !Writer.IsComplete()) {
+		UE_LOG(LogROS, Warning, TEXT("The template values of %s don't match its encoding, every message is encoded instead"), *MessageType);
+		bDisabled = true;
+	}
+	if (bDisabled) {
+		Document.Empty();
+		Slots.Empty();
+	}
+
+	const bool bAppended = bson_concat(message, &Encoded);
+	bson_destroy(&Encoded);
+	return bAppended;
+}
+
+bool FBSONMessageTemplate::CollectSlots(bson_iter_t& Iter, const uint8* Data, TArray<FBSONTemplateWriter::FSlot>& Slots)
+{
+	using ESlotType = FBSONTemplateWriter::ESlotType;
+
+	while (bson_iter_next(&Iter)) {
+		// nested iterators start at their document, Data at the outermost one
+		const uint32 Base = (uint32)(Iter.raw - Data);
+
+		switch (bson_iter_type(&Iter)) {
+		case BSON_TYPE_DOUBLE:
+			Slots.Add({ ESlotType::Double, Base + Iter.d1, 8 });
+			break;
+		case BSON_TYPE_INT32:
+			Slots.Add({ ESlotType::Int32, Base + Iter.d1, 4 });
+			break;
+		case BSON_TYPE_INT64:
+			Slots.Add({ ESlotType::Int64, Base + Iter.d1, 8 });
+			break;
+		case BSON_TYPE_BOOL:
+			Slots.Add({ ESlotType::Bool, Base + Iter.d1, 1 });
+			break;
+		case BSON_TYPE_UTF8:
+		{
+			uint32 Length = 0;
+			bson_iter_utf8(&Iter, &Length);
+			Slots.Add({ ESlotType::String, Base + Iter.d2, Length + 1 });
+			break;
+		}
+		case BSON_TYPE_ARRAY:
+		{
+			bson_iter_t Child;
+			if (!bson_iter_recurse(&Iter, &Child)) return false;
+			const int32 Array = Slots.Add({ ESlotType::Array, Base + Iter.d1, 0 });
+			while (bson_iter_next(&Child)) {
+				Slots[Array].Size++;
+			}
+			if (!bson_iter_recurse(&Iter, &Child) || !CollectSlots(Child, Data, Slots)) return false;
+			break;
+		}
+		case BSON_TYPE_DOCUMENT:
+		{
+			bson_iter_t Child;
+			if (!bson_iter_recurse(&Iter, &Child) || !CollectSlots(Child, Data, Slots)) return false;
+			break;
+		}
+		default:
+			// e.g. binary data, which doesn't have a fixed size
+			return false;
+		}
+	}
+	return true;
+}
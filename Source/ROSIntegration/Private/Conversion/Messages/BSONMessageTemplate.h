@@ -0,0 +1,167 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "ROSBaseMsg.h"
+#include <cstring>
+#include <bson.h>
+
+class UBaseMessageConverter;
+
+// Writes the values of a message into a pre-encoded bson document of the same layout.
+// Converters of fixed-layout messages pass every value in the order in which AppendOutgoingMessage
+// appends it, see UBaseMessageConverter::WriteTemplateValues.
+class FBSONTemplateWriter
+{
+public:
+	enum class ESlotType : uint8
+	{
+		Double,
+		Int32,
+		Int64,
+		Bool,
+		String,
+		Array,
+	};
+
+	// A value of the pre-encoded document
+	struct FSlot
+	{
+		ESlotType Type;
+		uint32 Offset; // of the value in the document
+		uint32 Size;   // of the value; the number of elements for arrays
+		FString String; // cached value of strings, so unchanged strings are not converted again
+	};
+
+	// With bVerify, the values are compared to the document instead of being written to it
+	FBSONTemplateWriter(uint8* Data, TArray<FSlot>& Slots, bool bVerify = false)
+	: Data(Data), Slots(Slots), bVerify(bVerify)
+	{
+	}
+
+	void Double(double Value)
+	{
+		const double LE = BSON_DOUBLE_TO_LE(Value);
+		Write(ESlotType::Double, &LE, sizeof(LE));
+	}
+
+	void Int32(int32 Value)
+	{
+		const uint32 LE = BSON_UINT32_TO_LE((uint32)Value);
+		Write(ESlotType::Int32, &LE, sizeof(LE));
+	}
+
+	void Int64(int64 Value)
+	{
+		const uint64 LE = BSON_UINT64_TO_LE((uint64)Value);
+		Write(ESlotType::Int64, &LE, sizeof(LE));
+	}
+
+	void Bool(bool Value)
+	{
+		const uint8 Byte = Value ? 1 : 0;
+		Write(ESlotType::Bool, &Byte, 1);
+	}
+
+	// Strings can only be patched with a string of the same length
+	void String(const FString& Value)
+	{
+		FSlot* Slot = NextSlot(ESlotType::String);
+		// FString == ignores case, which would keep "Map" in a slot patched with "map"
+		if (!Slot || (!bVerify && Slot->String.Equals(Value, ESearchCase::CaseSensitive))) return;
+
+		const FTCHARToUTF8 Converted(*Value);
+		if ((uint32)Converted.Length() + 1 != Slot->Size) {
+			bValid = false;
+			return;
+		}
+		WriteBytes(*Slot, Converted.Get(), Converted.Length());
+		Slot->String = Value;
+	}
+
+	// Starts an array, whose Num elements have to be written next.
+	// Arrays can only be patched with an array of the same number of elements.
+	void Array(int32 Num)
+	{
+		FSlot* Slot = NextSlot(ESlotType::Array);
+		if (Slot && Slot->Size != (uint32)Num) {
+			bValid = false;
+		}
+	}
+
+	template<class T>
+	void DoubleArray(const TArray<T>& Values)
+	{
+		Array(Values.Num());
+		for (const T& Value : Values) {
+			Double(Value);
+		}
+	}
+
+	// True if every value of the document has been written
+	bool IsComplete() const { return bValid && Next == Slots.Num(); }
+
+private:
+	FSlot* NextSlot(ESlotType Type)
+	{
+		if (!bValid || Next == Slots.Num() || Slots[Next].Type != Type) {
+			bValid = false;
+			return nullptr;
+		}
+		return &Slots[Next++];
+	}
+
+	void Write(ESlotType Type, const void* Bytes, uint32 Size)
+	{
+		if (FSlot* Slot = NextSlot(Type)) {
+			WriteBytes(*Slot, Bytes, Size);
+		}
+	}
+
+	void WriteBytes(const FSlot& Slot, const void* Bytes, uint32 Size)
+	{
+		if (!bVerify) {
+			FMemory::Memcpy(Data + Slot.Offset, Bytes, Size);
+		}
+		else if (FMemory::Memcmp(Data + Slot.Offset, Bytes, Size) != 0) {
+			bValid = false;
+		}
+	}
+
+	uint8* Data;
+	TArray<FSlot>& Slots;
+	const bool bVerify;
+	int32 Next = 0;
+	bool bValid = true;
+};
+
+/**
+ * Pre-encoded 'msg' document of a topic whose messages have a fixed layout, like sensor_msgs/Imu.
+ * The first message is encoded with AppendOutgoingMessage, later messages only patch their values into a copy of it
+ * with WriteTemplateValues, which is then appended as a whole. A message with a different layout, e.g. a longer
+ * frame_id, encodes the document again.
+ * If the values written by WriteTemplateValues don't match AppendOutgoingMessage, the topic keeps encoding every message.
+ * Topics only use it for converters that SupportsTemplate(), other messages are appended directly.
+ */
+class FBSONMessageTemplate
+{
+public:
+	// Appends the fields of BaseMsg to message, like UBaseMessageConverter::AppendOutgoingMessage
+	bool Append(UBaseMessageConverter* Converter, TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
+
+	// Appends the fields of a message of MessageType to message, AppendFields and WriteValues take the place of
+	// UBaseMessageConverter::AppendOutgoingMessage and UBaseMessageConverter::WriteTemplateValues
+	bool Append(const FString& MessageType, TFunctionRef<bool(bson_t*)> AppendFields, TFunctionRef<bool(FBSONTemplateWriter&)> WriteValues, bson_t* message);
+
+	// Forgets the encoded document, e.g. when the converter changes
+	void Reset();
+
+private:
+	bool Encode(const FString& MessageType, TFunctionRef<bool(bson_t*)> AppendFields, TFunctionRef<bool(FBSONTemplateWriter&)> WriteValues, bson_t* message);
+	static bool CollectSlots(bson_iter_t& Iter, const uint8* Data, TArray<FBSONTemplateWriter::FSlot>& Slots);
+
+	FCriticalSection Mutex;
+	TArray<uint8> Document;
+	TArray<FBSONTemplateWriter::FSlot> Slots;
+	bool bDisabled = false;
+};
@@ -11,7 +11,43 @@ bool UBaseMessageConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* me
 	return false;
 }
 
-bool UBaseMessageConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+// Converter whose default implementations currently call each other,
+// so a converter that overrides neither of them fails instead of recursing endlessly
+static thread_local const UBaseMessageConverter* DefaultOutgoingConversion = nullptr;
+
+bool UBaseMessageConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
+{
+	if (DefaultOutgoingConversion == this) return false;
+
+	bson_t* converted = nullptr;
+	DefaultOutgoingConversion = this;
+	bool bSuccess = ConvertOutgoingMessage(BaseMsg, &converted);
+	DefaultOutgoingConversion = nullptr;
+
+	if (converted) {
+		bSuccess = bSuccess && bson_concat(message, converted);
+		bson_destroy(converted);
+	}
+	return bSuccess;
+}
+
+bool UBaseMessageConverter::WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer)
+{
+	return false;
+}
+
+bool UBaseMessageConverter::SupportsTemplate() const
 {
 	return false;
 }
+
+bool UBaseMessageConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+{
+	if (DefaultOutgoingConversion == this) return false;
+
+	*message = bson_new();
+	DefaultOutgoingConversion = this;
+	const bool bSuccess = AppendOutgoingMessage(BaseMsg, *message);
+	DefaultOutgoingConversion = nullptr;
+	return bSuccess;
+}
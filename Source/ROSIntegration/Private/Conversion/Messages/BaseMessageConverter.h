@@ -10,8 +10,13 @@
 #include <UObject/ObjectMacros.h>
 #include <UObject/Object.h>
 #include "rosbridge2cpp/messages/rosbridge_publish_msg.h"
+#include "rosbridge2cpp/outgoing_message.h"
+#include "Conversion/Messages/BSONFieldDecoder.h"
+#include "Conversion/Messages/BSONMessageTemplate.h"
 #include <cstring>
 #include <functional>
+#include <memory>
+#include <type_traits>
 #include <bson.h>
 #include "std_msgs/Header.h"
 
@@ -22,6 +27,9 @@ class ROSINTEGRATION_API UBaseMessageConverter: public UObject
 {
 	GENERATED_UCLASS_BODY()
 
+	// The codecs of TTypedTopic encode messages with the helpers of their converters
+	template<class MsgT> friend struct TROSMessageCodec;
+
 public:
 	UPROPERTY()
 	FString _MessageType;
@@ -29,8 +37,41 @@ public:
 	// For ConvertMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg) {
 
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
+
+	// Appends the fields of BaseMsg to message, which is the 'msg' field of the outgoing rosbridge message.
+	// Converters should override this method, since it writes the message content only once.
+	// The default implementation falls back to ConvertOutgoingMessage and copies its result.
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
+
+	// Legacy interface that returns a separately allocated bson document.
+	// The default implementation uses AppendOutgoingMessage.
 	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
 
+	// Converters of messages with a fixed layout write the values of BaseMsg to Writer, in the order in which
+	// AppendOutgoingMessage appends them. Topics then patch the values into a pre-encoded message instead of
+	// encoding it again, see FBSONMessageTemplate. The default implementation returns false.
+	virtual bool WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer);
+
+	// True for converters that implement WriteTemplateValues. Topics append the messages of other converters
+	// directly with AppendOutgoingMessage. The default implementation returns false.
+	virtual bool SupportsTemplate() const;
+
+	// Decodes the 'msg' field of an incoming message in a single pass with the field table of its type
+	template<class T>
+	static bool DecodeMessage(const ROSBridgePublishMsg* message, const TBSONFieldDecoder<T>& Decoder, T& Value, bool LogOnErrors = true)
+	{
+		assert(message != nullptr);
+
+		bson_iter_t Iter;
+		if (!message->full_msg_bson_ || !bson_iter_init_find(&Iter, message->full_msg_bson_, "msg")) {
+			if (LogOnErrors) {
+				UE_LOG(LogROS, Error, TEXT("Key msg not present in data"));
+			}
+			return false;
+		}
+		return Decoder.DecodeValue(Iter, Value, LogOnErrors);
+	}
+
 	static double GetDoubleFromBSON(FString Key, bson_t* msg, bool &KeyFound, bool LogOnErrors=true)
 	{
 		assert(msg != nullptr);
@@ -75,14 +116,17 @@ public:
 		return value;
 	}
 
-	/// @note Example usage in GetDoubleTArrayFromBSON().
+	/// Decodes the array at Key, keyToT is called with the key of every element and the document that holds it.
+	/// @note Every element is handed over in a document of its own, so keyToT finds it right away
+	/// instead of searching the whole message. Use GetTArrayFromBSONElements() for new code.
 	template<class T>
 	static TArray<T> GetTArrayFromBSON(FString Key, bson_t* msg, bool &KeyFound, const std::function<T(FString, bson_t*, bool&)>& keyToT, bool LogOnErrors = true)
 	{
 		assert(msg != nullptr);
 
-		uint32_t array_size;
-		const uint8_t* data = rosbridge2cpp::Helper::get_array_by_key(TCHAR_TO_UTF8(*Key), *msg, array_size, KeyFound);
+		bson_iter_t iter, val, child;
+		KeyFound = bson_iter_init(&iter, msg) && bson_iter_find_descendant(&iter, TCHAR_TO_UTF8(*Key), &val) &&
+			BSON_ITER_HOLDS_ARRAY(&val) && bson_iter_recurse(&val, &child);
 		if (!KeyFound)
 		{
 			if (LogOnErrors) {
@@ -92,45 +136,184 @@ public:
 		}
 
 		TArray<T> ret;
-		bool elemFound = true;
-		for (int i = 0; elemFound; ++i)
+		ret.Reserve(FBSONValueReader::CountElements(val));
+		while (bson_iter_next(&child))
 		{
-			FString iKey = Key + "." + FString::FromInt(i);
-			elemFound = bson_has_field(msg, TCHAR_TO_UTF8(*iKey));
+			const char* elemKey = bson_iter_key(&child);
+			bson_t elem;
+			bson_init(&elem);
+			bool elemFound = bson_append_iter(&elem, elemKey, -1, &child);
 			if (elemFound)
 			{
-				T temp = keyToT(iKey, msg, elemFound);
-				ret.Add(temp);
+				T temp = keyToT(UTF8_TO_TCHAR(elemKey), &elem, elemFound);
+				if (elemFound)
+				{
+					ret.Add(temp);
+				}
+			}
+			bson_destroy(&elem);
+			if (!elemFound)
+			{
+				break;
 			}
 		}
 
 		return ret;
 	}
 
-	static TArray<double> GetDoubleTArrayFromBSON(FString Key, bson_t* msg, bool &KeyFound, bool LogOnErrors = true)
+	/// Decodes the array at Key in a single pass, ReadElement is called with an iterator on every element.
+	/// KeyFound is false if the array is missing or one of its elements can't be read.
+	template<class T>
+	static TArray<T> GetTArrayFromBSONElements(FString Key, bson_t* msg, bool &KeyFound, const std::function<bool(const bson_iter_t&, T&)>& ReadElement, bool LogOnErrors = true)
 	{
+		assert(msg != nullptr);
 
-		return GetTArrayFromBSON<double>(Key, msg, KeyFound, [](FString subKey, bson_t* subMsg, bool& subKeyFound) { return GetDoubleFromBSON(subKey, subMsg, subKeyFound, false); }, LogOnErrors);
+		TArray<T> ret;
+		bson_iter_t iter, val;
+		if (!bson_iter_init(&iter, msg) || !bson_iter_find_descendant(&iter, TCHAR_TO_UTF8(*Key), &val))
+		{
+			KeyFound = false;
+			if (LogOnErrors) {
+				UE_LOG(LogROS, Error, TEXT("Key %s not present in data"), *Key);
+			}
+			return ret;
+		}
+
+		KeyFound = FBSONValueReader::ReadArray(val, ret, ReadElement);
+		if (!KeyFound)
+		{
+			if (LogOnErrors) {
+				UE_LOG(LogROS, Error, TEXT("Key %s has an unexpected type or content"), *Key);
+			}
+			ret.Reset();
+		}
+		return ret;
+	}
+
+	/// Decodes an array of numbers, strings or ROS times at Key in a single pass
+	template<class T>
+	static TArray<T> GetValueTArrayFromBSON(FString Key, bson_t* msg, bool &KeyFound, bool LogOnErrors = true)
+	{
+		return GetTArrayFromBSONElements<T>(Key, msg, KeyFound, [](const bson_iter_t& iter, T& value) { return FBSONValueReader::Read(iter, value); }, LogOnErrors);
+	}
+
+	static TArray<double> GetDoubleTArrayFromBSON(FString Key, bson_t* msg, bool &KeyFound, bool LogOnErrors = true)
+	{
+		return GetValueTArrayFromBSON<double>(Key, msg, KeyFound, LogOnErrors);
 	}
 
 	static TArray<float> GetFloatTArrayFromBSON(FString Key, bson_t* msg, bool &KeyFound, bool LogOnErrors = true)
 	{
-		// bson doesn't support float, only double. So we use GetDoubleFromBSON internally
-		return GetTArrayFromBSON<float>(Key, msg, KeyFound, [](FString subKey, bson_t* subMsg, bool& subKeyFound) { return GetDoubleFromBSON(subKey, subMsg, subKeyFound, false); }, LogOnErrors);
+		// bson doesn't support float, only double. FBSONValueReader converts the doubles
+		return GetValueTArrayFromBSON<float>(Key, msg, KeyFound, LogOnErrors);
 	}
 	
 	static TArray<int32> GetInt32TArrayFromBSON(FString Key, bson_t* msg, bool &KeyFound, bool LogOnErrors = true)
 	{
-		return GetTArrayFromBSON<int32>(Key, msg, KeyFound, [](FString subKey, bson_t* subMsg, bool& subKeyFound) { return GetInt32FromBSON(subKey, subMsg, subKeyFound, false); }, LogOnErrors);
+		return GetValueTArrayFromBSON<int32>(Key, msg, KeyFound, LogOnErrors);
 	}
 
 protected:
 
 	// Helper function to append a TArray<float> to a bson_t
-	static void _bson_append_float_tarray(bson_t *b, const char *key, const TArray<float>& tarray)
+	static bool _bson_append_float_tarray(bson_t *b, const char *key, const TArray<float>& tarray)
 	{
 		// float -> double doesn't loose precision
-		_bson_append_double_tarray(b, key, (TArray<double>)tarray);
+		return _bson_append_numeric_tarray<double>(b, key, tarray);
+	}
+
+	// Appends a TArray of numbers as a bson array of V, which is double or int32.
+	// The array document is written in a single loop into a buffer of its final size and appended with one copy,
+	// instead of appending every element with its own key conversion and size check.
+	// Returns false if the array doesn't fit into a bson document, then nothing is appended.
+	template<class V, class T>
+	static bool _bson_append_numeric_tarray(bson_t *b, const char *key, const TArray<T>& tarray)
+	{
+		static_assert(std::is_same<V, double>::value || std::is_same<V, int32>::value, "bson arrays of double or int32 only");
+		const bson_type_t ElementType = std::is_same<V, double>::value ? BSON_TYPE_DOUBLE : BSON_TYPE_INT32;
+
+		// length, elements of type, key, key terminator and value, terminator
+		const int32 Num = tarray.Num();
+		const int64 Size = 4 + (int64)Num * (2 + sizeof(V)) + _bson_index_keys_length(Num) + 1;
+		if (Size > (int64)BSON_MAX_SIZE)
+		{
+			UE_LOG(LogROS, Error, TEXT("Array %s with %d elements exceeds the maximum bson document size"), UTF8_TO_TCHAR(key), Num);
+			return false;
+		}
+
+		// the buffer of a thread is reused for its small arrays, large ones release their memory afterwards
+		const int32 MaxRetainedBufferSize = 1024 * 1024;
+		static thread_local TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized((int32)Size, false);
+		uint8* Out = Buffer.GetData();
+
+		const uint32 SizeLE = BSON_UINT32_TO_LE((uint32)Size);
+		FMemory::Memcpy(Out, &SizeLE, 4);
+		Out += 4;
+
+		char ElementKey[16] = "0";
+		int32 ElementKeyLength = 1;
+		for (int32 i = 0; i < Num; ++i)
+		{
+			*Out++ = (uint8)ElementType;
+			FMemory::Memcpy(Out, ElementKey, ElementKeyLength + 1);
+			Out += ElementKeyLength + 1;
+			Out = _bson_write_le(Out, (V)tarray[i]);
+			_bson_next_index_key(ElementKey, ElementKeyLength);
+		}
+		*Out = 0;
+
+		bson_t arr;
+		const bool bAppended = bson_init_static(&arr, Buffer.GetData(), (size_t)Size) && bson_append_array(b, key, -1, &arr);
+		if (Buffer.Max() > MaxRetainedBufferSize)
+		{
+			Buffer.Empty();
+		}
+		return bAppended;
+	}
+
+	// Total length of the decimal keys "0" to "Num-1" of a bson array
+	static int64 _bson_index_keys_length(int32 Num)
+	{
+		int64 Length = 0;
+		for (int64 First = 0, Last = 10, Digits = 1; First < Num; First = Last, Last *= 10, ++Digits)
+		{
+			Length += (FMath::Min<int64>(Last, Num) - First) * Digits;
+		}
+		return Length;
+	}
+
+	// Advances a decimal bson array key in place, e.g. from "199" to "200"
+	static void _bson_next_index_key(char *key, int32& length)
+	{
+		int32 i = length - 1;
+		while (i >= 0 && key[i] == '9')
+		{
+			key[i--] = '0';
+		}
+		if (i >= 0)
+		{
+			++key[i];
+			return;
+		}
+		// all digits were 9, e.g. "99" -> "100"
+		key[0] = '1';
+		key[length++] = '0';
+		key[length] = 0;
+	}
+
+	static uint8* _bson_write_le(uint8* Out, double Value)
+	{
+		const double ValueLE = BSON_DOUBLE_TO_LE(Value);
+		FMemory::Memcpy(Out, &ValueLE, sizeof(ValueLE));
+		return Out + sizeof(ValueLE);
+	}
+
+	static uint8* _bson_write_le(uint8* Out, int32 Value)
+	{
+		const uint32 ValueLE = BSON_UINT32_TO_LE((uint32)Value);
+		FMemory::Memcpy(Out, &ValueLE, sizeof(ValueLE));
+		return Out + sizeof(ValueLE);
 	}
 
 	template<class T>
@@ -149,27 +332,46 @@ protected:
 	}
 
 	// Helper function to append a TArray<double> to a bson_t
-	static void _bson_append_double_tarray(bson_t *b, const char *key, const TArray<double>& tarray)
+	static bool _bson_append_double_tarray(bson_t *b, const char *key, const TArray<double>& tarray)
 	{
-		_bson_append_tarray<double>(b, key, tarray, [](bson_t *subb, const char *subKey, double d) { BSON_APPEND_DOUBLE(subb, subKey, d); });
+		return _bson_append_numeric_tarray<double>(b, key, tarray);
 	}
 
-	// Helper function to append a TArray<uint8> to a bson_t
-	static void _bson_append_uint8_tarray(bson_t *b, const char *key, const TArray<uint8>& tarray)
+	// Helper function to append a TArray<uint8> to a bson_t.
+	// uint8[] fields are sent as bson binary, which rosbridge decodes like an array of numbers.
+	// Returns false if the array doesn't fit into the message.
+	static bool _bson_append_uint8_tarray(bson_t *b, const char *key, const TArray<uint8>& tarray)
 	{
-		// uint8 -> uint32 doesn't loose precision
-		_bson_append_uint32_tarray(b, key, (TArray<uint32>)tarray);
+		return bson_append_binary(b, key, -1, BSON_SUBTYPE_BINARY, tarray.GetData(), tarray.Num());
+	}
+
+	// Helper function to append the first Length bytes of a shared buffer as binary data to a bson_t.
+	// Within the content of a published message, the data is sent directly from Buffer instead of being copied,
+	// and Buffer is kept alive until then.
+	// Returns false if Buffer holds less than Length bytes, the message would not match its declared dimensions.
+	static bool _bson_append_shared_binary(bson_t *b, const char *key, const TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>& Buffer, uint32 Length)
+	{
+		check(Buffer.IsValid());
+		if ((uint32)Buffer->Num() < Length)
+		{
+			UE_LOG(LogROS, Error, TEXT("Binary field %s needs %u bytes, but its buffer only holds %d"), UTF8_TO_TCHAR(key), Length, Buffer->Num());
+			return false;
+		}
+		TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Owner = Buffer;
+		return rosbridge2cpp::OutgoingMessage::AppendBinary(b, key, Buffer->GetData(), Length,
+			std::shared_ptr<const void>(Buffer->GetData(), [Owner](const void*) mutable { Owner.Reset(); }));
 	}
 
 	// Helper function to append a TArray<int32> to a bson_t
-	static void _bson_append_int32_tarray(bson_t *b, const char *key, const TArray<int32>& tarray)
+	static bool _bson_append_int32_tarray(bson_t *b, const char *key, const TArray<int32>& tarray)
 	{
-		_bson_append_tarray<int32>(b, key, tarray, [](bson_t *subb, const char *subKey, int32 i) { BSON_APPEND_INT32(subb, subKey, i); });
+		return _bson_append_numeric_tarray<int32>(b, key, tarray);
 	}
 	
 	// Helper function to append a TArray<uint32> to a bson_t
-	static void _bson_append_uint32_tarray(bson_t *b, const char *key, const TArray<uint32>& tarray)
+	static bool _bson_append_uint32_tarray(bson_t *b, const char *key, const TArray<uint32>& tarray)
 	{
-		_bson_append_tarray<uint32>(b, key, tarray, [](bson_t *subb, const char *subKey, uint32 i) { BSON_APPEND_INT32(subb, subKey, i); });
+		// bson has no unsigned int32, values above INT32_MAX wrap around like before
+		return _bson_append_numeric_tarray<int32>(b, key, tarray);
 	}
 };
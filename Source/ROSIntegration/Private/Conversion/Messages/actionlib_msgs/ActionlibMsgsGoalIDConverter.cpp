@@ -11,16 +11,14 @@ bool UActionlibMsgsGoalIDConverter::ConvertIncomingMessage(const ROSBridgePublis
 {
 	auto g = new ROSMessages::actionlib_msgs::GoalID();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(g);
-	return _bson_extract_child_goal_id(message->full_msg_bson_, "msg", g);
+	return DecodeMessage(message, _bson_goal_id_decoder(), *g);
 }
 
-bool UActionlibMsgsGoalIDConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UActionlibMsgsGoalIDConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto GoalID = StaticCastSharedPtr<ROSMessages::actionlib_msgs::GoalID>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_goal_id(*message, GoalID.Get());
+	_bson_append_goal_id(message, GoalID.Get());
 
 	return true;
 }
@@ -15,17 +15,20 @@ class ROSINTEGRATION_API UActionlibMsgsGoalIDConverter : public UBaseMessageConv
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_goal_id(bson_t *b, FString key, ROSMessages::actionlib_msgs::GoalID *g, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::actionlib_msgs::GoalID>& _bson_goal_id_decoder()
 	{
-		bool KeyFound = false;
-		int32 Sec =   GetInt32FromBSON(key + ".stamp.secs", b, KeyFound, LogOnErrors);  if (!KeyFound) return false;
-		int32 NSec =  GetInt32FromBSON(key + ".stamp.nsecs", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		g->id = GetFStringFromBSON(key + ".id", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		g->stamp = FROSTime(Sec, NSec);
+		using ROSMessages::actionlib_msgs::GoalID;
+		static const auto Decoder = TBSONFieldDecoder<GoalID>()
+			.Field("stamp", &GoalID::stamp)
+			.Field("id", &GoalID::id);
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_goal_id(bson_t *b, FString key, ROSMessages::actionlib_msgs::GoalID *g, bool LogOnErrors = true)
+	{
+		return _bson_goal_id_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *g, LogOnErrors);
 	}
 
 	static void _bson_append_child_goal_id(bson_t *b, const char *key, const ROSMessages::actionlib_msgs::GoalID *g)
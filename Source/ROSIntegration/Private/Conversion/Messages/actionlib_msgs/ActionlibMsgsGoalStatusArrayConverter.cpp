@@ -11,16 +11,14 @@ bool UActionlibMsgsGoalStatusArrayConverter::ConvertIncomingMessage(const ROSBri
 {
 	auto g = new ROSMessages::actionlib_msgs::GoalStatusArray();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(g);
-	return _bson_extract_child_goal_status_array(message->full_msg_bson_, "msg", g);
+	return DecodeMessage(message, _bson_goal_status_array_decoder(), *g);
 }
 
-bool UActionlibMsgsGoalStatusArrayConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UActionlibMsgsGoalStatusArrayConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto GoalStatusArray = StaticCastSharedPtr<ROSMessages::actionlib_msgs::GoalStatusArray>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_goal_status_array(*message, GoalStatusArray.Get());
+	_bson_append_goal_status_array(message, GoalStatusArray.Get());
 
 	return true;
 }
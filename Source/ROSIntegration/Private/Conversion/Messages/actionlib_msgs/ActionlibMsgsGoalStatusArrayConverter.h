@@ -17,22 +17,20 @@ class ROSINTEGRATION_API UActionlibMsgsGoalStatusArrayConverter : public UBaseMe
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_goal_status_array(bson_t *b, FString key, ROSMessages::actionlib_msgs::GoalStatusArray *g, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::actionlib_msgs::GoalStatusArray>& _bson_goal_status_array_decoder()
 	{
-		bool KeyFound = false;
-
-		KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(b, key + ".header", &g->header); if (!KeyFound) return false;
-		g->status_list = GetTArrayFromBSON<ROSMessages::actionlib_msgs::GoalStatus>(key + ".status_list", b, KeyFound, [LogOnErrors](FString subKey, bson_t* subMsg, bool& subKeyFound)
-		{
-			ROSMessages::actionlib_msgs::GoalStatus ret;
-			subKeyFound = UActionlibMsgsGoalStatusConverter::_bson_extract_child_goal_status(subMsg, subKey, &ret, LogOnErrors);
-			return ret;
-		}, LogOnErrors);
-		if (!KeyFound) return false;
+		using ROSMessages::actionlib_msgs::GoalStatusArray;
+		static const auto Decoder = TBSONFieldDecoder<GoalStatusArray>()
+			.Field("header", &GoalStatusArray::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+			.Field("status_list", &GoalStatusArray::status_list, UActionlibMsgsGoalStatusConverter::_bson_goal_status_decoder());
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_goal_status_array(bson_t *b, FString key, ROSMessages::actionlib_msgs::GoalStatusArray *g, bool LogOnErrors = true)
+	{
+		return _bson_goal_status_array_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *g, LogOnErrors);
 	}
 
 	static void _bson_append_child_goal_status_array(bson_t *b, const char *key, const ROSMessages::actionlib_msgs::GoalStatusArray *g)
@@ -11,16 +11,14 @@ bool UActionlibMsgsGoalStatusConverter::ConvertIncomingMessage(const ROSBridgePu
 {
 	auto g = new ROSMessages::actionlib_msgs::GoalStatus();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(g);
-	return _bson_extract_child_goal_status(message->full_msg_bson_, "msg", g);
+	return DecodeMessage(message, _bson_goal_status_decoder(), *g);
 }
 
-bool UActionlibMsgsGoalStatusConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UActionlibMsgsGoalStatusConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto GoalStatus = StaticCastSharedPtr<ROSMessages::actionlib_msgs::GoalStatus>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_goal_status(*message, GoalStatus.Get());
+	_bson_append_goal_status(message, GoalStatus.Get());
 
 	return true;
 }
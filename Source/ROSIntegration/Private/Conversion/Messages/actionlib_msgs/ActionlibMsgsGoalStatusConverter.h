@@ -16,16 +16,21 @@ class ROSINTEGRATION_API UActionlibMsgsGoalStatusConverter : public UBaseMessage
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_goal_status(bson_t *b, FString key, ROSMessages::actionlib_msgs::GoalStatus *g, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::actionlib_msgs::GoalStatus>& _bson_goal_status_decoder()
 	{
-		bool KeyFound = false;
-		KeyFound = UActionlibMsgsGoalIDConverter::_bson_extract_child_goal_id(b, key + ".goal_id", &g->goal_id, LogOnErrors); if (!KeyFound) return false;
-		g->status = static_cast<ROSMessages::actionlib_msgs::GoalStatus::Status>( GetInt32FromBSON(key + ".status", b, KeyFound, LogOnErrors) );  if (!KeyFound) return false; // TODO: there is no GetUInt8FromBSON, do we need to implement that?
-		g->text = GetFStringFromBSON(key + ".text", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
+		using ROSMessages::actionlib_msgs::GoalStatus;
+		static const auto Decoder = TBSONFieldDecoder<GoalStatus>()
+			.Field("goal_id", &GoalStatus::goal_id, UActionlibMsgsGoalIDConverter::_bson_goal_id_decoder())
+			.Field("status", &GoalStatus::status)
+			.Field("text", &GoalStatus::text);
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_goal_status(bson_t *b, FString key, ROSMessages::actionlib_msgs::GoalStatus *g, bool LogOnErrors = true)
+	{
+		return _bson_goal_status_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *g, LogOnErrors);
 	}
 
 	static void _bson_append_child_goal_status(bson_t *b, const char *key, const ROSMessages::actionlib_msgs::GoalStatus *g)
@@ -12,16 +12,14 @@ bool UGeometryMsgsPointConverter::ConvertIncomingMessage(const ROSBridgePublishM
 {
 	auto p = new ROSMessages::geometry_msgs::Point();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_point(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_point_decoder(), *p);
 }
 
-bool UGeometryMsgsPointConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsPointConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Point = StaticCastSharedPtr<ROSMessages::geometry_msgs::Point>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_point(*message, Point.Get());
+	_bson_append_point(message, Point.Get());
 
 	return true;
 }
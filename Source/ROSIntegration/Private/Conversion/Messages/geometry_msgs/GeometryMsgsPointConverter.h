@@ -16,17 +16,22 @@ class ROSINTEGRATION_API UGeometryMsgsPointConverter : public UBaseMessageConver
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
 
-	static bool _bson_extract_child_point(bson_t *b, FString key, ROSMessages::geometry_msgs::Point *p, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::geometry_msgs::Point>& _bson_point_decoder()
 	{
-		bool KeyFound = false;
+		using ROSMessages::geometry_msgs::Point;
+		static const auto Decoder = TBSONFieldDecoder<Point>()
+			.Field("x", &Point::x)
+			.Field("y", &Point::y)
+			.Field("z", &Point::z);
+		return Decoder;
+	}
 
-		p->x = GetDoubleFromBSON(key + ".x", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		p->y = GetDoubleFromBSON(key + ".y", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		p->z = GetDoubleFromBSON(key + ".z", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		return true;
+	static bool _bson_extract_child_point(bson_t *b, FString key, ROSMessages::geometry_msgs::Point *p, bool LogOnErrors = true)
+	{
+		return _bson_point_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *p, LogOnErrors);
 	}
 
 
@@ -45,4 +50,11 @@ public:
 		BSON_APPEND_DOUBLE(b, "y", p->y);
 		BSON_APPEND_DOUBLE(b, "z", p->z);
 	}
+
+	static void _bson_write_point(FBSONTemplateWriter& w, const ROSMessages::geometry_msgs::Point *p)
+	{
+		w.Double(p->x);
+		w.Double(p->y);
+		w.Double(p->z);
+	}
 };
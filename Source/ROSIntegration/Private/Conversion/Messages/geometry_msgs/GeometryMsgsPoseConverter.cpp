@@ -11,16 +11,14 @@ bool UGeometryMsgsPoseConverter::ConvertIncomingMessage(const ROSBridgePublishMs
 {
 	auto p = new ROSMessages::geometry_msgs::Pose();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_pose(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_pose_decoder(), *p);
 }
 
-bool UGeometryMsgsPoseConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsPoseConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Pose = StaticCastSharedPtr<ROSMessages::geometry_msgs::Pose>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_pose(*message, Pose.Get());
+	_bson_append_pose(message, Pose.Get());
 
 	return true;
 }
@@ -18,14 +18,20 @@ class ROSINTEGRATION_API UGeometryMsgsPoseConverter : public UBaseMessageConvert
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_pose(bson_t *b, FString key, ROSMessages::geometry_msgs::Pose *p, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::geometry_msgs::Pose>& _bson_pose_decoder()
 	{
-		if (!UGeometryMsgsPointConverter::_bson_extract_child_point(b, key + ".position", &p->position, LogOnErrors)) return false;
-		if (!UGeometryMsgsQuaternionConverter::_bson_extract_child_quaternion(b, key + ".orientation", &p->orientation, LogOnErrors)) return false;
+		using ROSMessages::geometry_msgs::Pose;
+		static const auto Decoder = TBSONFieldDecoder<Pose>()
+			.Field("position", &Pose::position, UGeometryMsgsPointConverter::_bson_point_decoder())
+			.Field("orientation", &Pose::orientation, UGeometryMsgsQuaternionConverter::_bson_quaternion_decoder());
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_pose(bson_t *b, FString key, ROSMessages::geometry_msgs::Pose *p, bool LogOnErrors = true)
+	{
+		return _bson_pose_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *p, LogOnErrors);
 	}
 
 	static void _bson_append_child_pose(bson_t *b, const char *key, const ROSMessages::geometry_msgs::Pose *t)
@@ -41,4 +47,10 @@ public:
 		UGeometryMsgsPointConverter::_bson_append_child_point(b, "position", &(t->position));
 		UGeometryMsgsQuaternionConverter::_bson_append_child_quaternion(b, "orientation", &(t->orientation));
 	}
+
+	static void _bson_write_pose(FBSONTemplateWriter& w, const ROSMessages::geometry_msgs::Pose *t)
+	{
+		UGeometryMsgsPointConverter::_bson_write_point(w, &(t->position));
+		UGeometryMsgsQuaternionConverter::_bson_write_quaternion(w, &(t->orientation));
+	}
 };
@@ -1,31 +1,52 @@
 #include "Conversion/Messages/geometry_msgs/GeometryMsgsPoseStampedConverter.h"
 
+#include "ROSMessageCodec.h"
+
 
 UGeometryMsgsPoseStampedConverter::UGeometryMsgsPoseStampedConverter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
-	_MessageType = "geometry_msgs/PoseStamped";
+	_MessageType = TROSMessageCodec<ROSMessages::geometry_msgs::PoseStamped>::MessageType();
 }
 
-bool UGeometryMsgsPoseStampedConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+bool TROSMessageCodec<ROSMessages::geometry_msgs::PoseStamped>::Decode(const ROSBridgePublishMsg& message, ROSMessages::geometry_msgs::PoseStamped& Msg)
 {
-	auto p = new ROSMessages::geometry_msgs::PoseStamped();
-	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
+	return UBaseMessageConverter::DecodeMessage(&message, UGeometryMsgsPoseStampedConverter::_bson_pose_stamped_decoder(), Msg);
+}
 
-	if (!UStdMsgsHeaderConverter::_bson_extract_child_header(message->full_msg_bson_, TEXT("msg.header"), &p->header)) return false;
-	if (!UGeometryMsgsPoseConverter::_bson_extract_child_pose(message->full_msg_bson_, TEXT("msg.pose"), &p->pose)) return false;
+bool TROSMessageCodec<ROSMessages::geometry_msgs::PoseStamped>::Append(const ROSMessages::geometry_msgs::PoseStamped& Msg, bson_t* message)
+{
+	UGeometryMsgsPoseStampedConverter::_bson_append_pose_stamped(message, &Msg);
+	return true;
+}
 
+bool TROSMessageCodec<ROSMessages::geometry_msgs::PoseStamped>::WriteTemplateValues(const ROSMessages::geometry_msgs::PoseStamped& Msg, FBSONTemplateWriter& Writer)
+{
+	UStdMsgsHeaderConverter::_bson_write_header(Writer, &(Msg.header));
+	UGeometryMsgsPoseConverter::_bson_write_pose(Writer, &(Msg.pose));
 	return true;
 }
 
-bool UGeometryMsgsPoseStampedConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsPoseStampedConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
 {
-	auto PoseStamped = StaticCastSharedPtr<ROSMessages::geometry_msgs::PoseStamped>(BaseMsg);
+	auto p = new ROSMessages::geometry_msgs::PoseStamped();
+	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
+	return TROSMessageCodec<ROSMessages::geometry_msgs::PoseStamped>::Decode(*message, *p);
+}
 
-	*message = new bson_t;
-	bson_init(*message);
+bool UGeometryMsgsPoseStampedConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
+{
+	auto PoseStamped = StaticCastSharedPtr<ROSMessages::geometry_msgs::PoseStamped>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::geometry_msgs::PoseStamped>::Append(*PoseStamped, message);
+}
 
-	_bson_append_pose_stamped(*message, PoseStamped.Get());
+bool UGeometryMsgsPoseStampedConverter::WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer)
+{
+	auto PoseStamped = StaticCastSharedPtr<ROSMessages::geometry_msgs::PoseStamped>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::geometry_msgs::PoseStamped>::WriteTemplateValues(*PoseStamped, Writer);
+}
 
+bool UGeometryMsgsPoseStampedConverter::SupportsTemplate() const
+{
 	return true;
 }
@@ -18,19 +18,22 @@ class ROSINTEGRATION_API UGeometryMsgsPoseStampedConverter : public UBaseMessage
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
+	virtual bool WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer);
+	virtual bool SupportsTemplate() const;
 
-	static bool _bson_extract_child_pose_stamped(bson_t *b, FString key, ROSMessages::geometry_msgs::PoseStamped * ps, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::geometry_msgs::PoseStamped>& _bson_pose_stamped_decoder()
 	{
-		bool KeyFound = false;
-
-		KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(b, key + ".header", &ps->header);
-		if (!KeyFound) return false;
-
-		KeyFound = UGeometryMsgsPoseConverter::_bson_extract_child_pose(b, key + ".pose", &ps->pose);
-		if (!KeyFound) return false;
+		using ROSMessages::geometry_msgs::PoseStamped;
+		static const auto Decoder = TBSONFieldDecoder<PoseStamped>()
+			.Field("header", &PoseStamped::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+			.Field("pose", &PoseStamped::pose, UGeometryMsgsPoseConverter::_bson_pose_decoder());
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_pose_stamped(bson_t *b, FString key, ROSMessages::geometry_msgs::PoseStamped * ps, bool LogOnErrors = true)
+	{
+		return _bson_pose_stamped_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *ps, LogOnErrors);
 	}
 
 	static void _bson_append_child_pose_stamped(bson_t *b, const char *key, const ROSMessages::geometry_msgs::PoseStamped * ps)
@@ -11,16 +11,12 @@ bool UGeometryMsgsPoseWithCovarianceConverter::ConvertIncomingMessage(const ROSB
 {
 	auto p = new ROSMessages::geometry_msgs::PoseWithCovariance();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_pose_with_covariance(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_pose_with_covariance_decoder(), *p);
 }
 
-bool UGeometryMsgsPoseWithCovarianceConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsPoseWithCovarianceConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Pose = StaticCastSharedPtr<ROSMessages::geometry_msgs::PoseWithCovariance>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_pose_with_covariance(*message, Pose.Get());
-
-	return true;
+	return _bson_append_pose_with_covariance(message, Pose.Get());
 }
@@ -17,33 +17,41 @@ class ROSINTEGRATION_API UGeometryMsgsPoseWithCovarianceConverter : public UBase
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_pose_with_covariance(bson_t *b, FString key, ROSMessages::geometry_msgs::PoseWithCovariance *p, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::geometry_msgs::PoseWithCovariance>& _bson_pose_with_covariance_decoder()
 	{
-		bool KeyFound = false;
-
-		if (!UGeometryMsgsPoseConverter::_bson_extract_child_pose(b, key + ".pose", &p->pose, LogOnErrors))
-			return false;
-
-		p->covariance = GetDoubleTArrayFromBSON(key + ".covariance", b, KeyFound, LogOnErrors);
-		if (!KeyFound || p->covariance.Num() != 36) // TODO: Magic Number?
-			return false;
+		using ROSMessages::geometry_msgs::PoseWithCovariance;
+		static const auto Decoder = TBSONFieldDecoder<PoseWithCovariance>()
+			.Field("pose", &PoseWithCovariance::pose, UGeometryMsgsPoseConverter::_bson_pose_decoder())
+			.Field("covariance", &PoseWithCovariance::covariance)
+			.Validate([](const PoseWithCovariance& p) { return p.covariance.Num() == 36; }); // 6x6 covariance matrix
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_pose_with_covariance(bson_t *b, FString key, ROSMessages::geometry_msgs::PoseWithCovariance *p, bool LogOnErrors = true)
+	{
+		return _bson_pose_with_covariance_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *p, LogOnErrors);
 	}
 
-	static void _bson_append_child_pose_with_covariance(bson_t *b, const char *key, ROSMessages::geometry_msgs::PoseWithCovariance *t)
+	static bool _bson_append_child_pose_with_covariance(bson_t *b, const char *key, const ROSMessages::geometry_msgs::PoseWithCovariance *t)
 	{
 		bson_t pose;
 		BSON_APPEND_DOCUMENT_BEGIN(b, key, &pose);
-		_bson_append_pose_with_covariance(&pose, t);
+		const bool bAppended = _bson_append_pose_with_covariance(&pose, t);
 		bson_append_document_end(b, &pose);
+		return bAppended;
 	}
 
-	static void _bson_append_pose_with_covariance(bson_t *b, const ROSMessages::geometry_msgs::PoseWithCovariance *t)
+	static bool _bson_append_pose_with_covariance(bson_t *b, const ROSMessages::geometry_msgs::PoseWithCovariance *t)
 	{
 		UGeometryMsgsPoseConverter::_bson_append_child_pose(b, "pose", &(t->pose));
-		_bson_append_double_tarray(b, "covariance", t->covariance);
+		return _bson_append_double_tarray(b, "covariance", t->covariance);
+	}
+
+	static void _bson_write_pose_with_covariance(FBSONTemplateWriter& w, const ROSMessages::geometry_msgs::PoseWithCovariance *t)
+	{
+		UGeometryMsgsPoseConverter::_bson_write_pose(w, &(t->pose));
+		w.DoubleArray(t->covariance);
 	}
 };
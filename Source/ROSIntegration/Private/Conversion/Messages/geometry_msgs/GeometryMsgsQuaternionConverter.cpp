@@ -11,16 +11,14 @@ bool UGeometryMsgsQuaternionConverter::ConvertIncomingMessage(const ROSBridgePub
 {
 	auto p = new ROSMessages::geometry_msgs::Quaternion();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_quaternion(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_quaternion_decoder(), *p);
 }
 
-bool UGeometryMsgsQuaternionConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsQuaternionConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Quaternion = StaticCastSharedPtr<ROSMessages::geometry_msgs::Quaternion>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_quaternion(*message, Quaternion.Get());
+	_bson_append_quaternion(message, Quaternion.Get());
 
 	return true;
 }
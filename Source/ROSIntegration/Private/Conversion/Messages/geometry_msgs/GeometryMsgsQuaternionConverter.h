@@ -16,18 +16,23 @@ class ROSINTEGRATION_API UGeometryMsgsQuaternionConverter: public UBaseMessageCo
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
 
-	static bool _bson_extract_child_quaternion(bson_t *b, FString key, ROSMessages::geometry_msgs::Quaternion *q, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::geometry_msgs::Quaternion>& _bson_quaternion_decoder()
 	{
-		bool KeyFound = false;
+		using ROSMessages::geometry_msgs::Quaternion;
+		static const auto Decoder = TBSONFieldDecoder<Quaternion>()
+			.Field("x", &Quaternion::x)
+			.Field("y", &Quaternion::y)
+			.Field("z", &Quaternion::z)
+			.Field("w", &Quaternion::w);
+		return Decoder;
+	}
 
-		q->x = GetDoubleFromBSON(key + ".x", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		q->y = GetDoubleFromBSON(key + ".y", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		q->z = GetDoubleFromBSON(key + ".z", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		q->w = GetDoubleFromBSON(key + ".w", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		return true;
+	static bool _bson_extract_child_quaternion(bson_t *b, FString key, ROSMessages::geometry_msgs::Quaternion *q, bool LogOnErrors = true)
+	{
+		return _bson_quaternion_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *q, LogOnErrors);
 	}
 
 
@@ -47,4 +52,12 @@ public:
 		BSON_APPEND_DOUBLE(b, "z", q->z);
 		BSON_APPEND_DOUBLE(b, "w", q->w);
 	}
+
+	static void _bson_write_quaternion(FBSONTemplateWriter& w, const ROSMessages::geometry_msgs::Quaternion *q)
+	{
+		w.Double(q->x);
+		w.Double(q->y);
+		w.Double(q->z);
+		w.Double(q->w);
+	}
 };
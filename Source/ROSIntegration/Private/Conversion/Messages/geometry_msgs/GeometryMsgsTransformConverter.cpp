@@ -13,16 +13,14 @@ bool UGeometryMsgsTransformConverter::ConvertIncomingMessage(const ROSBridgePubl
     UE_LOG(LogTemp, Warning, TEXT("ROSIntegration: Transform received"));
     auto p = new ROSMessages::geometry_msgs::Transform;
     BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-    return (_bson_extract_child_transform(message->full_msg_bson_, "msg", p));
+    return DecodeMessage(message, _bson_transform_decoder(), *p);
 }
 
-bool UGeometryMsgsTransformConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsTransformConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Transform = StaticCastSharedPtr<ROSMessages::geometry_msgs::Transform>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_transform(*message, Transform.Get());
+	_bson_append_transform(message, Transform.Get());
 
 	return true;
 }
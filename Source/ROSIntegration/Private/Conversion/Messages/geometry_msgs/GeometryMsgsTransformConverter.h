@@ -18,24 +18,31 @@ class ROSINTEGRATION_API UGeometryMsgsTransformConverter: public UBaseMessageCon
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
+
+    static const TBSONFieldDecoder<ROSMessages::geometry_msgs::Transform>& _bson_transform_decoder()
+    {
+        using ROSMessages::geometry_msgs::Transform;
+        static const auto Decoder = TBSONFieldDecoder<Transform>()
+            .Field("translation", &Transform::translation, UGeometryMsgsVector3Converter::_bson_vector3_decoder())
+            .Field("rotation", &Transform::rotation, UGeometryMsgsQuaternionConverter::_bson_quaternion_decoder());
+        return Decoder;
+    }
 
     static bool _bson_extract_child_transform(bson_t *b, FString key, ROSMessages::geometry_msgs::Transform *p, bool LogOnErrors = true)
     {
-        if (!UGeometryMsgsVector3Converter::_bson_extract_child_vector3(b, key + ".translation", &(p->translation))) return false;
-        if (!UGeometryMsgsQuaternionConverter::_bson_extract_child_quaternion(b, key + ".rotation", &(p->rotation))) return false;
-        return true;
+        return _bson_transform_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *p, LogOnErrors);
     }
     
-    static void _bson_append_child_transform(bson_t *b, const char *key, ROSMessages::geometry_msgs::Transform *t)
+    static void _bson_append_child_transform(bson_t *b, const char *key, const ROSMessages::geometry_msgs::Transform *t)
 	{
 		bson_t tform;
 		BSON_APPEND_DOCUMENT_BEGIN(b, key, &tform);
-		_bson_append_transform(b, t);
+		_bson_append_transform(&tform, t);
 		bson_append_document_end(b, &tform);
 	}
 
-	static void _bson_append_transform(bson_t *b, ROSMessages::geometry_msgs::Transform *t)
+	static void _bson_append_transform(bson_t *b, const ROSMessages::geometry_msgs::Transform *t)
 	{
 		UGeometryMsgsVector3Converter::_bson_append_child_vector3(b, "translation", &(t->translation));
 		UGeometryMsgsQuaternionConverter::_bson_append_child_quaternion(b, "rotation", &(t->rotation));
@@ -15,18 +15,14 @@ bool UGeometryMsgsTransformStampedConverter::ConvertIncomingMessage(const ROSBri
     UE_LOG(LogTemp, Warning, TEXT("ROSIntegration: TransformStamped received"));
     auto p = new ROSMessages::geometry_msgs::TransformStamped;
     BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-    return (_bson_extract_child_transform_stamped(message->full_msg_bson_, "msg", p));
+    return DecodeMessage(message, _bson_transform_stamped_decoder(), *p);
 }
 
-bool UGeometryMsgsTransformStampedConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsTransformStampedConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto TransformStamped = StaticCastSharedPtr<ROSMessages::geometry_msgs::TransformStamped>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	UStdMsgsHeaderConverter::_bson_append_header(*message, &(TransformStamped->header));
-	BSON_APPEND_UTF8(*message, "child_frame_id", TCHAR_TO_UTF8(*TransformStamped->child_frame_id));
-	UGeometryMsgsTransformConverter::_bson_append_child_transform(*message, "transform", &(TransformStamped->transform));
+	_bson_append_transform_stamped(message, TransformStamped.Get());
 
 	return true;
 }
@@ -18,14 +18,35 @@ class ROSINTEGRATION_API UGeometryMsgsTransformStampedConverter: public UBaseMes
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
+
+    static const TBSONFieldDecoder<ROSMessages::geometry_msgs::TransformStamped>& _bson_transform_stamped_decoder()
+    {
+        using ROSMessages::geometry_msgs::TransformStamped;
+        static const auto Decoder = TBSONFieldDecoder<TransformStamped>()
+            .Field("header", &TransformStamped::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+            .Field("child_frame_id", &TransformStamped::child_frame_id)
+            .Field("transform", &TransformStamped::transform, UGeometryMsgsTransformConverter::_bson_transform_decoder());
+        return Decoder;
+    }
 
     static bool _bson_extract_child_transform_stamped(bson_t *b, FString key, ROSMessages::geometry_msgs::TransformStamped *p, bool LogOnErrors = true)
     {
-        bool keyFound = false;
-        if (!UStdMsgsHeaderConverter::_bson_extract_child_header(b, key + ".header", &(p->header), LogOnErrors)) return false;
-        p->child_frame_id = GetFStringFromBSON(key + ".child_frame_id", b, keyFound, LogOnErrors); if (!keyFound) return false;
-        if (!UGeometryMsgsTransformConverter::_bson_extract_child_transform(b, key + ".transform", &(p->transform), LogOnErrors)) return false;
-        return true;
+        return _bson_transform_stamped_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *p, LogOnErrors);
+    }
+
+    static void _bson_append_child_transform_stamped(bson_t *b, const char *key, const ROSMessages::geometry_msgs::TransformStamped *ts)
+    {
+        bson_t tform;
+        BSON_APPEND_DOCUMENT_BEGIN(b, key, &tform);
+        _bson_append_transform_stamped(&tform, ts);
+        bson_append_document_end(b, &tform);
+    }
+
+    static void _bson_append_transform_stamped(bson_t *b, const ROSMessages::geometry_msgs::TransformStamped *ts)
+    {
+        UStdMsgsHeaderConverter::_bson_append_header(b, &(ts->header));
+        BSON_APPEND_UTF8(b, "child_frame_id", TCHAR_TO_UTF8(*ts->child_frame_id));
+        UGeometryMsgsTransformConverter::_bson_append_child_transform(b, "transform", &(ts->transform));
     }
 };
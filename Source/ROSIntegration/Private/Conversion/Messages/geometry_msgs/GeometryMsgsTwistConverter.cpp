@@ -1,26 +1,51 @@
 #include "Conversion/Messages/geometry_msgs/GeometryMsgsTwistConverter.h"
 
+#include "ROSMessageCodec.h"
+
 
 UGeometryMsgsTwistConverter::UGeometryMsgsTwistConverter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
-	_MessageType = "geometry_msgs/Twist";
+	_MessageType = TROSMessageCodec<ROSMessages::geometry_msgs::Twist>::MessageType();
+}
+
+bool TROSMessageCodec<ROSMessages::geometry_msgs::Twist>::Decode(const ROSBridgePublishMsg& message, ROSMessages::geometry_msgs::Twist& Msg)
+{
+	return UBaseMessageConverter::DecodeMessage(&message, UGeometryMsgsTwistConverter::_bson_twist_decoder(), Msg);
+}
+
+bool TROSMessageCodec<ROSMessages::geometry_msgs::Twist>::Append(const ROSMessages::geometry_msgs::Twist& Msg, bson_t* message)
+{
+	UGeometryMsgsTwistConverter::_bson_append_twist(message, &Msg);
+	return true;
+}
+
+bool TROSMessageCodec<ROSMessages::geometry_msgs::Twist>::WriteTemplateValues(const ROSMessages::geometry_msgs::Twist& Msg, FBSONTemplateWriter& Writer)
+{
+	UGeometryMsgsTwistConverter::_bson_write_twist(Writer, &Msg);
+	return true;
 }
 
 bool UGeometryMsgsTwistConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
 {
 	auto p = new ROSMessages::geometry_msgs::Twist();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_twist(message->full_msg_bson_, "msg", p);
+	return TROSMessageCodec<ROSMessages::geometry_msgs::Twist>::Decode(*message, *p);
 }
 
-bool UGeometryMsgsTwistConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsTwistConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Twist = StaticCastSharedPtr<ROSMessages::geometry_msgs::Twist>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::geometry_msgs::Twist>::Append(*Twist, message);
+}
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_twist(*message, Twist.Get());
+bool UGeometryMsgsTwistConverter::WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer)
+{
+	auto Twist = StaticCastSharedPtr<ROSMessages::geometry_msgs::Twist>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::geometry_msgs::Twist>::WriteTemplateValues(*Twist, Writer);
+}
 
+bool UGeometryMsgsTwistConverter::SupportsTemplate() const
+{
 	return true;
 }
@@ -17,14 +17,22 @@ class ROSINTEGRATION_API UGeometryMsgsTwistConverter : public UBaseMessageConver
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
+	virtual bool WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer);
+	virtual bool SupportsTemplate() const;
 
-	static bool _bson_extract_child_twist(bson_t *b, FString key, ROSMessages::geometry_msgs::Twist *p, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::geometry_msgs::Twist>& _bson_twist_decoder()
 	{
-		if (!UGeometryMsgsVector3Converter::_bson_extract_child_vector3(b, key + ".linear", &p->linear, LogOnErrors)) return false;
-		if (!UGeometryMsgsVector3Converter::_bson_extract_child_vector3(b, key + ".angular", &p->angular, LogOnErrors)) return false;
+		using ROSMessages::geometry_msgs::Twist;
+		static const auto Decoder = TBSONFieldDecoder<Twist>()
+			.Field("linear", &Twist::linear, UGeometryMsgsVector3Converter::_bson_vector3_decoder())
+			.Field("angular", &Twist::angular, UGeometryMsgsVector3Converter::_bson_vector3_decoder());
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_twist(bson_t *b, FString key, ROSMessages::geometry_msgs::Twist *p, bool LogOnErrors = true)
+	{
+		return _bson_twist_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *p, LogOnErrors);
 	}
 
 	static void _bson_append_child_twist(bson_t *b, const char *key, const ROSMessages::geometry_msgs::Twist *t)
@@ -40,4 +48,10 @@ public:
 		UGeometryMsgsVector3Converter::_bson_append_child_vector3(b, "linear", &(t->linear));
 		UGeometryMsgsVector3Converter::_bson_append_child_vector3(b, "angular", &(t->angular));
 	}
+
+	static void _bson_write_twist(FBSONTemplateWriter& w, const ROSMessages::geometry_msgs::Twist *t)
+	{
+		UGeometryMsgsVector3Converter::_bson_write_vector3(w, &(t->linear));
+		UGeometryMsgsVector3Converter::_bson_write_vector3(w, &(t->angular));
+	}
 };
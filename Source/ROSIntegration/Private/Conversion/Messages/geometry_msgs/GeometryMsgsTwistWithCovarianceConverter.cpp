@@ -11,16 +11,12 @@ bool UGeometryMsgsTwistWithCovarianceConverter::ConvertIncomingMessage(const ROS
 {
 	auto p = new ROSMessages::geometry_msgs::TwistWithCovariance();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_twist_with_covariance(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_twist_with_covariance_decoder(), *p);
 }
 
-bool UGeometryMsgsTwistWithCovarianceConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsTwistWithCovarianceConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Pose = StaticCastSharedPtr<ROSMessages::geometry_msgs::TwistWithCovariance>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_twist_with_covariance(*message, Pose.Get());
-
-	return true;
+	return _bson_append_twist_with_covariance(message, Pose.Get());
 }
@@ -17,33 +17,41 @@ class ROSINTEGRATION_API UGeometryMsgsTwistWithCovarianceConverter : public UBas
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_twist_with_covariance(bson_t *b, FString key, ROSMessages::geometry_msgs::TwistWithCovariance *p, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::geometry_msgs::TwistWithCovariance>& _bson_twist_with_covariance_decoder()
 	{
-		bool KeyFound = false;
-
-		if (!UGeometryMsgsTwistConverter::_bson_extract_child_twist(b, key + ".twist", &p->twist, LogOnErrors))
-			return false;
-
-		p->covariance = GetDoubleTArrayFromBSON(key + ".covariance", b, KeyFound, LogOnErrors);
-		if (!KeyFound || p->covariance.Num() != 36) // TODO: Magic Number?
-			return false;
+		using ROSMessages::geometry_msgs::TwistWithCovariance;
+		static const auto Decoder = TBSONFieldDecoder<TwistWithCovariance>()
+			.Field("twist", &TwistWithCovariance::twist, UGeometryMsgsTwistConverter::_bson_twist_decoder())
+			.Field("covariance", &TwistWithCovariance::covariance)
+			.Validate([](const TwistWithCovariance& p) { return p.covariance.Num() == 36; }); // 6x6 covariance matrix
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_twist_with_covariance(bson_t *b, FString key, ROSMessages::geometry_msgs::TwistWithCovariance *p, bool LogOnErrors = true)
+	{
+		return _bson_twist_with_covariance_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *p, LogOnErrors);
 	}
 
-	static void _bson_append_child_twist_with_covariance(bson_t *b, const char *key, const ROSMessages::geometry_msgs::TwistWithCovariance *t)
+	static bool _bson_append_child_twist_with_covariance(bson_t *b, const char *key, const ROSMessages::geometry_msgs::TwistWithCovariance *t)
 	{
 		bson_t twist;
 		BSON_APPEND_DOCUMENT_BEGIN(b, key, &twist);
-		_bson_append_twist_with_covariance(&twist, t);
+		const bool bAppended = _bson_append_twist_with_covariance(&twist, t);
 		bson_append_document_end(b, &twist);
+		return bAppended;
 	}
 
-	static void _bson_append_twist_with_covariance(bson_t *b, const ROSMessages::geometry_msgs::TwistWithCovariance *t)
+	static bool _bson_append_twist_with_covariance(bson_t *b, const ROSMessages::geometry_msgs::TwistWithCovariance *t)
 	{
 		UGeometryMsgsTwistConverter::_bson_append_child_twist(b, "twist", &(t->twist));
-		_bson_append_double_tarray(b, "covariance", t->covariance);
+		return _bson_append_double_tarray(b, "covariance", t->covariance);
+	}
+
+	static void _bson_write_twist_with_covariance(FBSONTemplateWriter& w, const ROSMessages::geometry_msgs::TwistWithCovariance *t)
+	{
+		UGeometryMsgsTwistConverter::_bson_write_twist(w, &(t->twist));
+		w.DoubleArray(t->covariance);
 	}
 };
@@ -12,16 +12,14 @@ bool UGeometryMsgsVector3Converter::ConvertIncomingMessage(const ROSBridgePublis
 {
 	auto p = new ROSMessages::geometry_msgs::Vector3();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_vector3(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_vector3_decoder(), *p);
 }
 
-bool UGeometryMsgsVector3Converter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGeometryMsgsVector3Converter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Vector3 = StaticCastSharedPtr<ROSMessages::geometry_msgs::Vector3>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_vector3(*message, Vector3.Get());
+	_bson_append_vector3(message, Vector3.Get());
 
 	return true;
 }
@@ -15,17 +15,22 @@ class ROSINTEGRATION_API UGeometryMsgsVector3Converter: public UBaseMessageConve
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
 
-	static bool _bson_extract_child_vector3(bson_t *b, FString key, ROSMessages::geometry_msgs::Vector3 *p, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::geometry_msgs::Vector3>& _bson_vector3_decoder()
 	{
-		bool KeyFound = false;
+		using ROSMessages::geometry_msgs::Vector3;
+		static const auto Decoder = TBSONFieldDecoder<Vector3>()
+			.Field("x", &Vector3::x)
+			.Field("y", &Vector3::y)
+			.Field("z", &Vector3::z);
+		return Decoder;
+	}
 
-		p->x = GetDoubleFromBSON(key + ".x", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		p->y = GetDoubleFromBSON(key + ".y", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		p->z = GetDoubleFromBSON(key + ".z", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		return true;
+	static bool _bson_extract_child_vector3(bson_t *b, FString key, ROSMessages::geometry_msgs::Vector3 *p, bool LogOnErrors = true)
+	{
+		return _bson_vector3_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *p, LogOnErrors);
 	}
 
 	static void _bson_append_child_vector3(bson_t *b, const char *key, const ROSMessages::geometry_msgs::Vector3 *v3)
@@ -43,4 +48,11 @@ public:
 		BSON_APPEND_DOUBLE(b, "y", v3->y);
 		BSON_APPEND_DOUBLE(b, "z", v3->z);
 	}
+
+	static void _bson_write_vector3(FBSONTemplateWriter& w, const ROSMessages::geometry_msgs::Vector3 *v3)
+	{
+		w.Double(v3->x);
+		w.Double(v3->y);
+		w.Double(v3->z);
+	}
 };
@@ -10,16 +10,14 @@ bool UGridMapMsgsGridMapConverter::ConvertIncomingMessage(const ROSBridgePublish
 {
 	auto p = new ROSMessages::grid_map_msgs::GridMap;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_grid_map(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_grid_map_decoder(), *p);
 }
 
-bool UGridMapMsgsGridMapConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGridMapMsgsGridMapConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto map = StaticCastSharedPtr<ROSMessages::grid_map_msgs::GridMap>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_grid_map(*message, map.Get());
+	_bson_append_grid_map(message, map.Get());
 
 	return true;
 }
@@ -18,28 +18,24 @@ class ROSINTEGRATION_API UGridMapMsgsGridMapConverter : public UBaseMessageConve
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_grid_map(bson_t *b, FString key, ROSMessages::grid_map_msgs::GridMap *gm)
+	static const TBSONFieldDecoder<ROSMessages::grid_map_msgs::GridMap>& _bson_grid_map_decoder()
 	{
-		bool KeyFound = false;
-
-		KeyFound = UGridMapMsgsGridMapInfoConverter::_bson_extract_child_grid_map_info(b, key + ".info", &gm->info); if (!KeyFound) return false;
-
-		gm->layers = GetTArrayFromBSON<FString>(key + ".layers", b, KeyFound, [](FString subKey, bson_t* subMsg, bool& subKeyFound) { return GetFStringFromBSON(subKey, subMsg, subKeyFound, false); });
-		gm->basic_layers = GetTArrayFromBSON<FString>(key + ".basic_layers", b, KeyFound, [](FString subKey, bson_t* subMsg, bool& subKeyFound) { return GetFStringFromBSON(subKey, subMsg, subKeyFound, false); });
-
-		gm->data = GetTArrayFromBSON<ROSMessages::std_msgs::Float32MultiArray>(key + ".data", b, KeyFound, [](FString subKey, bson_t* subMsg, bool& subKeyFound) {
-			ROSMessages::std_msgs::Float32MultiArray ret;
-			subKeyFound = UStdMsgsFloat32MultiArrayConverter::_bson_extract_child_float_multi_array(subMsg, subKey, &ret, false);
-			return ret;
-		});
-		if (!KeyFound) return false;
-
-		gm->outer_start_index = GetInt32FromBSON(key + ".outer_start_index", b, KeyFound); if (!KeyFound) return false;
-		gm->inner_start_index = GetInt32FromBSON(key + ".inner_start_index", b, KeyFound); if (!KeyFound) return false;
+		using ROSMessages::grid_map_msgs::GridMap;
+		static const auto Decoder = TBSONFieldDecoder<GridMap>()
+			.Field("info", &GridMap::info, UGridMapMsgsGridMapInfoConverter::_bson_grid_map_info_decoder())
+			.Field("layers", &GridMap::layers, false)
+			.Field("basic_layers", &GridMap::basic_layers, false)
+			.Field("data", &GridMap::data, UStdMsgsFloat32MultiArrayConverter::_bson_float_multi_array_decoder())
+			.Field("outer_start_index", &GridMap::outer_start_index)
+			.Field("inner_start_index", &GridMap::inner_start_index);
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_grid_map(bson_t *b, FString key, ROSMessages::grid_map_msgs::GridMap *gm)
+	{
+		return _bson_grid_map_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *gm);
 	}
 
 	static void _bson_append_child_grid_map(bson_t *b, const char *key, ROSMessages::grid_map_msgs::GridMap *gm)
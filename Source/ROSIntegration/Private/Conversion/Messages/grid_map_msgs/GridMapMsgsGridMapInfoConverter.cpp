@@ -11,16 +11,14 @@ bool UGridMapMsgsGridMapInfoConverter::ConvertIncomingMessage(const ROSBridgePub
 {
 	auto p = new ROSMessages::grid_map_msgs::GridMapInfo;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_grid_map_info(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_grid_map_info_decoder(), *p);
 }
 
-bool UGridMapMsgsGridMapInfoConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UGridMapMsgsGridMapInfoConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Info = StaticCastSharedPtr<ROSMessages::grid_map_msgs::GridMapInfo>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_grid_map_info(*message, Info.Get());
+	_bson_append_grid_map_info(message, Info.Get());
 
 	return true;
 }
@@ -18,19 +18,23 @@ class ROSINTEGRATION_API UGridMapMsgsGridMapInfoConverter : public UBaseMessageC
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_grid_map_info(bson_t *b, FString key, ROSMessages::grid_map_msgs::GridMapInfo *g)
+	static const TBSONFieldDecoder<ROSMessages::grid_map_msgs::GridMapInfo>& _bson_grid_map_info_decoder()
 	{
-		bool KeyFound = false;
-
-		KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(b, key + ".header", &g->header); if (!KeyFound) return false;
-		g->resolution = GetDoubleFromBSON(key + ".resolution", b, KeyFound);							if (!KeyFound) return false;
-		g->length_x = GetDoubleFromBSON(key + ".length_x", b, KeyFound);								if (!KeyFound) return false;
-		g->length_y = GetDoubleFromBSON(key + ".length_y", b, KeyFound);								if (!KeyFound) return false;
-		KeyFound = UGeometryMsgsPoseConverter::_bson_extract_child_pose(b, key + ".pose", &g->pose);	if (!KeyFound) return false;
+		using ROSMessages::grid_map_msgs::GridMapInfo;
+		static const auto Decoder = TBSONFieldDecoder<GridMapInfo>()
+			.Field("header", &GridMapInfo::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+			.Field("resolution", &GridMapInfo::resolution)
+			.Field("length_x", &GridMapInfo::length_x)
+			.Field("length_y", &GridMapInfo::length_y)
+			.Field("pose", &GridMapInfo::pose, UGeometryMsgsPoseConverter::_bson_pose_decoder());
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_grid_map_info(bson_t *b, FString key, ROSMessages::grid_map_msgs::GridMapInfo *g)
+	{
+		return _bson_grid_map_info_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *g);
 	}
 
 	static void _bson_append_child_grid_map_info(bson_t *b, const char *key, const ROSMessages::grid_map_msgs::GridMapInfo *g)
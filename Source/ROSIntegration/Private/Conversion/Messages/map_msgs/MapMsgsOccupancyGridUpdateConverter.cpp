@@ -0,0 +1,45 @@
+#include "MapMsgsOccupancyGridUpdateConverter.h"
+
+#include "map_msgs/OccupancyGridUpdate.h"
+#include "Conversion/Messages/std_msgs/StdMsgsHeaderConverter.h"
+
+UMapMsgsOccupancyGridUpdateConverter::UMapMsgsOccupancyGridUpdateConverter(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	_MessageType = "map_msgs/OccupancyGridUpdate";
+}
+
+static const TBSONFieldDecoder<ROSMessages::map_msgs::OccupancyGridUpdate>& _bson_occupancy_grid_update_decoder()
+{
+	using ROSMessages::map_msgs::OccupancyGridUpdate;
+	static const auto Decoder = TBSONFieldDecoder<OccupancyGridUpdate>()
+		.Field("header", &OccupancyGridUpdate::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+		.Field("x", &OccupancyGridUpdate::x)
+		.Field("y", &OccupancyGridUpdate::y)
+		.Field("width", &OccupancyGridUpdate::width)
+		.Field("height", &OccupancyGridUpdate::height)
+		.Field("data", [](const bson_iter_t& Iter, OccupancyGridUpdate& Update) { return FBSONValueReader::ReadInt32Array(Iter, Update.data); })
+		.Validate([](const OccupancyGridUpdate& Update) { return (int64)Update.data.Num() == (int64)Update.width * Update.height; });
+	return Decoder;
+}
+
+bool UMapMsgsOccupancyGridUpdateConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+{
+	auto u = new ROSMessages::map_msgs::OccupancyGridUpdate();
+	BaseMsg = TSharedPtr<FROSBaseMsg>(u);
+	return DecodeMessage(message, _bson_occupancy_grid_update_decoder(), *u);
+}
+
+bool UMapMsgsOccupancyGridUpdateConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
+{
+	auto update = StaticCastSharedPtr<ROSMessages::map_msgs::OccupancyGridUpdate>(BaseMsg);
+
+	UStdMsgsHeaderConverter::_bson_append_header(message, &(update->header));
+
+	BSON_APPEND_INT32(message, "x", update->x);
+	BSON_APPEND_INT32(message, "y", update->y);
+	BSON_APPEND_INT32(message, "width", update->width);
+	BSON_APPEND_INT32(message, "height", update->height);
+
+	return _bson_append_numeric_tarray<int32>(message, "data", update->data);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/ObjectMacros.h>
+#include <UObject/Object.h>
+#include "Conversion/Messages/BaseMessageConverter.h"
+
+#include "MapMsgsOccupancyGridUpdateConverter.generated.h"
+
+
+UCLASS()
+class ROSINTEGRATION_API UMapMsgsOccupancyGridUpdateConverter : public UBaseMessageConverter
+{
+	GENERATED_UCLASS_BODY()
+	
+public:
+	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
+};
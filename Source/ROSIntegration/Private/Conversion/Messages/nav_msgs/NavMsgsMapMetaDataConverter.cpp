@@ -14,16 +14,14 @@ bool UNavMsgsMapMetaDataConverter::ConvertIncomingMessage(const ROSBridgePublish
 {
 	auto p = new ROSMessages::nav_msgs::MapMetaData;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_map_meta_data(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_map_meta_data_decoder(), *p);
 }
 
-bool UNavMsgsMapMetaDataConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UNavMsgsMapMetaDataConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto map = StaticCastSharedPtr<ROSMessages::nav_msgs::MapMetaData>(BaseMsg);
 	
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_map_meta_data(*message, map.Get());
+	_bson_append_map_meta_data(message, map.Get());
 	
 	return true;
 }
@@ -4,6 +4,7 @@
 #include <UObject/ObjectMacros.h>
 #include <UObject/Object.h>
 #include "Conversion/Messages/BaseMessageConverter.h"
+#include "Conversion/Messages/geometry_msgs/GeometryMsgsPoseConverter.h"
 #include "nav_msgs/MapMetaData.h"
 #include "NavMsgsMapMetaDataConverter.generated.h"
 
@@ -15,27 +16,27 @@ class ROSINTEGRATION_API UNavMsgsMapMetaDataConverter : public UBaseMessageConve
 	
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 	
 	// Helper function to extract a child-std_msgs/Header from a bson_t
+	static const TBSONFieldDecoder<ROSMessages::nav_msgs::MapMetaData>& _bson_map_meta_data_decoder()
+	{
+		using ROSMessages::nav_msgs::MapMetaData;
+		static const auto Decoder = TBSONFieldDecoder<MapMetaData>()
+			.Field("map_load_time", &MapMetaData::map_load_time)
+			.Field("resolution", &MapMetaData::resolution)
+			.Field("width", &MapMetaData::width)
+			.Field("height", &MapMetaData::height)
+			.Field("origin", &MapMetaData::origin, UGeometryMsgsPoseConverter::_bson_pose_decoder());
+		return Decoder;
+	}
+
 	static bool _bson_extract_child_map_meta_data(bson_t *b, FString key, ROSMessages::nav_msgs::MapMetaData *mmd)
 	{
-		bool KeyFound = false;
-		int32 Sec =  GetInt32FromBSON(key + ".map_load_time.secs",  b, KeyFound);  if (!KeyFound) return false;
-		int32 NSec = GetInt32FromBSON(key + ".map_load_time.nsecs", b, KeyFound); if (!KeyFound) return false;
-		mmd->map_load_time = FROSTime(Sec, NSec);
-		
-		mmd->resolution = (float)GetDoubleFromBSON(key + ".resolution", b, KeyFound);  if (!KeyFound) return false;
-		
-		mmd->width = GetInt32FromBSON(key + ".width", b, KeyFound); if (!KeyFound) return false;
-		mmd->height = GetInt32FromBSON(key + ".height", b, KeyFound); if (!KeyFound) return false;
-		
-		if (!UGeometryMsgsPoseConverter::_bson_extract_child_pose(b, key + ".origin", &mmd->origin)) return false;
-		
-		return true;
+		return _bson_map_meta_data_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *mmd);
 	}
 	
-	static void _bson_append_child_map_meta_data(bson_t *b, const char *key, ROSMessages::nav_msgs::MapMetaData *mmd)
+	static void _bson_append_child_map_meta_data(bson_t *b, const char *key, const ROSMessages::nav_msgs::MapMetaData *mmd)
 	{
 		bson_t mapmetadata;
 		BSON_APPEND_DOCUMENT_BEGIN(b, key, &mapmetadata);
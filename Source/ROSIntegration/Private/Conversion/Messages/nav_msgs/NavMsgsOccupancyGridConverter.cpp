@@ -1,47 +1,63 @@
 #include "NavMsgsOccupancyGridConverter.h"
 
-#include "nav_msgs/OccupancyGrid.h"
+#include "ROSMessageCodec.h"
 #include "Conversion/Messages/std_msgs/StdMsgsHeaderConverter.h"
 #include "NavMsgsMapMetaDataConverter.h"
 
+
 UNavMsgsOccupancyGridConverter::UNavMsgsOccupancyGridConverter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
-	_MessageType = "nav_msgs/OccupancyGrid";
+	_MessageType = TROSMessageCodec<ROSMessages::nav_msgs::OccupancyGrid>::MessageType();
+}
+
+static const TBSONFieldDecoder<ROSMessages::nav_msgs::OccupancyGrid>& _bson_occupancy_grid_decoder()
+{
+	using ROSMessages::nav_msgs::OccupancyGrid;
+	static const auto Decoder = TBSONFieldDecoder<OccupancyGrid>()
+		.Field("header", &OccupancyGrid::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+		.Field("info", &OccupancyGrid::info, UNavMsgsMapMetaDataConverter::_bson_map_meta_data_decoder())
+		.Field("data", [](const bson_iter_t& Iter, OccupancyGrid& Grid) {
+			// the grid that is decoded into selects the storage
+			return Grid.int8_storage ? FBSONValueReader::ReadInt32Array(Iter, Grid.data_int8) : FBSONValueReader::ReadInt32Array(Iter, Grid.data);
+		});
+	return Decoder;
+}
+
+bool TROSMessageCodec<ROSMessages::nav_msgs::OccupancyGrid>::Decode(const ROSBridgePublishMsg& message, ROSMessages::nav_msgs::OccupancyGrid& Msg)
+{
+	return UBaseMessageConverter::DecodeMessage(&message, _bson_occupancy_grid_decoder(), Msg);
+}
+
+bool TROSMessageCodec<ROSMessages::nav_msgs::OccupancyGrid>::Append(const ROSMessages::nav_msgs::OccupancyGrid& Grid, bson_t* message)
+{
+	UStdMsgsHeaderConverter::_bson_append_header(message, &(Grid.header));
+
+	UNavMsgsMapMetaDataConverter::_bson_append_child_map_meta_data(message, "info", &(Grid.info));
+
+	if (Grid.int8_storage) {
+		return UBaseMessageConverter::_bson_append_numeric_tarray<int32>(message, "data", Grid.data_int8);
+	}
+	return UBaseMessageConverter::_bson_append_int32_tarray(message, "data", Grid.data);
+}
+
+bool TROSMessageCodec<ROSMessages::nav_msgs::OccupancyGrid>::WriteTemplateValues(const ROSMessages::nav_msgs::OccupancyGrid& Grid, FBSONTemplateWriter& Writer)
+{
+	// the length of the cell array changes with the size of the map
+	return false;
 }
 
 bool UNavMsgsOccupancyGridConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
 {
 	auto o = new ROSMessages::nav_msgs::OccupancyGrid();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(o);
-	
-	bool KeyFound = false;
-	KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(message->full_msg_bson_, TEXT("msg.header"), &o->header);
-	if (!KeyFound) return false;
-	
-	KeyFound = UNavMsgsMapMetaDataConverter::_bson_extract_child_map_meta_data(message->full_msg_bson_, TEXT("msg.info"), &o->info);
-	if (!KeyFound) return false;
-	
-	o->data = GetInt32TArrayFromBSON(TEXT("msg.data"), message->full_msg_bson_, KeyFound);
-	if (!KeyFound) return false;
-	
-	return true;
+	return TROSMessageCodec<ROSMessages::nav_msgs::OccupancyGrid>::Decode(*message, *o);
 }
 
-bool UNavMsgsOccupancyGridConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UNavMsgsOccupancyGridConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto grid = StaticCastSharedPtr<ROSMessages::nav_msgs::OccupancyGrid>(BaseMsg);
-	
-	*message = new bson_t;
-	bson_init(*message);
-	
-	UStdMsgsHeaderConverter::_bson_append_header(*message, &(grid->header));
-	
-	UNavMsgsMapMetaDataConverter::_bson_append_child_map_meta_data(*message, "info", &(grid->info));
-	
-	_bson_append_int32_tarray(*message, "data", grid->data);
-	
-	return true;
+	return TROSMessageCodec<ROSMessages::nav_msgs::OccupancyGrid>::Append(*grid, message);
 }
 
 
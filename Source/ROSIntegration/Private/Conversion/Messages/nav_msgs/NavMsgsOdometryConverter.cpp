@@ -1,6 +1,7 @@
 #include "NavMsgsOdometryConverter.h"
 
 #include "nav_msgs/Odometry.h"
+#include "ROSMessageCodec.h"
 #include "Conversion/Messages/std_msgs/StdMsgsHeaderConverter.h"
 #include "Conversion/Messages/geometry_msgs/GeometryMsgsPoseWithCovarianceConverter.h"
 #include "Conversion/Messages/geometry_msgs/GeometryMsgsTwistWithCovarianceConverter.h"
@@ -9,44 +10,65 @@
 UNavMsgsOdometryConverter::UNavMsgsOdometryConverter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
-	_MessageType = "nav_msgs/Odometry";
+	_MessageType = TROSMessageCodec<ROSMessages::nav_msgs::Odometry>::MessageType();
 }
 
-bool UNavMsgsOdometryConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+static const TBSONFieldDecoder<ROSMessages::nav_msgs::Odometry>& _bson_odometry_decoder()
 {
-	auto o = new ROSMessages::nav_msgs::Odometry();
-	BaseMsg = TSharedPtr<FROSBaseMsg>(o);
-
-	bool KeyFound = false;
-	KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(message->full_msg_bson_, TEXT("msg.header"), &o->header);
-	if (!KeyFound) return false;
+	using ROSMessages::nav_msgs::Odometry;
+	static const auto Decoder = TBSONFieldDecoder<Odometry>()
+		.Field("header", &Odometry::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+		.Field("child_frame_id", &Odometry::child_frame_id)
+		.Field("pose", &Odometry::pose, UGeometryMsgsPoseWithCovarianceConverter::_bson_pose_with_covariance_decoder())
+		.Field("twist", &Odometry::twist, UGeometryMsgsTwistWithCovarianceConverter::_bson_twist_with_covariance_decoder());
+	return Decoder;
+}
 
-	o->child_frame_id = GetFStringFromBSON(TEXT("msg.child_frame_id"), message->full_msg_bson_, KeyFound);
-	if (!KeyFound) return false;
+bool TROSMessageCodec<ROSMessages::nav_msgs::Odometry>::Decode(const ROSBridgePublishMsg& message, ROSMessages::nav_msgs::Odometry& Msg)
+{
+	return UBaseMessageConverter::DecodeMessage(&message, _bson_odometry_decoder(), Msg);
+}
 
-	KeyFound = UGeometryMsgsPoseWithCovarianceConverter::_bson_extract_child_pose_with_covariance(message->full_msg_bson_, TEXT("msg.pose"), &o->pose);
-	if (!KeyFound) return false;
+bool TROSMessageCodec<ROSMessages::nav_msgs::Odometry>::Append(const ROSMessages::nav_msgs::Odometry& Odometry, bson_t* message)
+{
+	UStdMsgsHeaderConverter::_bson_append_header(message, &(Odometry.header));
 
-	KeyFound = UGeometryMsgsTwistWithCovarianceConverter::_bson_extract_child_twist_with_covariance(message->full_msg_bson_, TEXT("msg.twist"), &o->twist);
-	if (!KeyFound) return false;
+	BSON_APPEND_UTF8(message, "child_frame_id", TCHAR_TO_UTF8(*Odometry.child_frame_id));
 
-	return true;
+	return UGeometryMsgsPoseWithCovarianceConverter::_bson_append_child_pose_with_covariance(message, "pose", &(Odometry.pose))
+		&& UGeometryMsgsTwistWithCovarianceConverter::_bson_append_child_twist_with_covariance(message, "twist", &(Odometry.twist));
 }
 
-bool UNavMsgsOdometryConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool TROSMessageCodec<ROSMessages::nav_msgs::Odometry>::WriteTemplateValues(const ROSMessages::nav_msgs::Odometry& Odometry, FBSONTemplateWriter& Writer)
 {
-	auto Odometry = StaticCastSharedPtr<ROSMessages::nav_msgs::Odometry>(BaseMsg);
+	UStdMsgsHeaderConverter::_bson_write_header(Writer, &(Odometry.header));
+	Writer.String(Odometry.child_frame_id);
+	UGeometryMsgsPoseWithCovarianceConverter::_bson_write_pose_with_covariance(Writer, &(Odometry.pose));
+	UGeometryMsgsTwistWithCovarianceConverter::_bson_write_twist_with_covariance(Writer, &(Odometry.twist));
 
-	*message = new bson_t;
-	bson_init(*message);
+	return true;
+}
 
-	UStdMsgsHeaderConverter::_bson_append_header(*message, &(Odometry->header));
+bool UNavMsgsOdometryConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+{
+	auto o = new ROSMessages::nav_msgs::Odometry();
+	BaseMsg = TSharedPtr<FROSBaseMsg>(o);
+	return TROSMessageCodec<ROSMessages::nav_msgs::Odometry>::Decode(*message, *o);
+}
 
-	const char* id = TCHAR_TO_UTF8(*Odometry->child_frame_id);
-	BSON_APPEND_UTF8(*message, "child_frame_id", id);
+bool UNavMsgsOdometryConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
+{
+	auto Odometry = StaticCastSharedPtr<ROSMessages::nav_msgs::Odometry>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::nav_msgs::Odometry>::Append(*Odometry, message);
+}
 
-	UGeometryMsgsPoseWithCovarianceConverter::_bson_append_child_pose_with_covariance(*message, "pose", &(Odometry->pose));
-	UGeometryMsgsTwistWithCovarianceConverter::_bson_append_child_twist_with_covariance(*message, "twist", &(Odometry->twist));
+bool UNavMsgsOdometryConverter::WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer)
+{
+	auto Odometry = StaticCastSharedPtr<ROSMessages::nav_msgs::Odometry>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::nav_msgs::Odometry>::WriteTemplateValues(*Odometry, Writer);
+}
 
+bool UNavMsgsOdometryConverter::SupportsTemplate() const
+{
 	return true;
 }
@@ -4,6 +4,8 @@
 #include <UObject/ObjectMacros.h>
 #include <UObject/Object.h>
 #include "Conversion/Messages/BaseMessageConverter.h"
+#include "Conversion/Messages/std_msgs/StdMsgsHeaderConverter.h"
+#include "Conversion/Messages/geometry_msgs/GeometryMsgsPoseStampedConverter.h"
 #include "nav_msgs/Path.h"
 
 #include "NavMsgsPathConverter.generated.h"
@@ -16,22 +18,19 @@ class ROSINTEGRATION_API UNavMsgsPathConverter : public UBaseMessageConverter
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_path(bson_t *b, FString key, ROSMessages::nav_msgs::Path * path, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::nav_msgs::Path>& _bson_path_decoder()
 	{
-		bool KeyFound = false;
-		KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(b, TEXT("msg.header"), &path->header);
-		if (!KeyFound) return false;
-
-		path->poses = GetTArrayFromBSON<ROSMessages::geometry_msgs::PoseStamped>(key + ".poses", b, KeyFound, [LogOnErrors](FString subKey, bson_t* subMsg, bool& subKeyFound)
-		{
-			ROSMessages::geometry_msgs::PoseStamped ret;
-			subKeyFound = UGeometryMsgsPoseStampedConverter::_bson_extract_child_pose_stamped(subMsg, subKey, &ret, LogOnErrors);
-			return ret;
-		}, LogOnErrors);
-		if (!KeyFound) return false;
+		using ROSMessages::nav_msgs::Path;
+		static const auto Decoder = TBSONFieldDecoder<Path>()
+			.Field("header", &Path::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+			.Field("poses", &Path::poses, UGeometryMsgsPoseStampedConverter::_bson_pose_stamped_decoder());
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_path(bson_t *b, FString key, ROSMessages::nav_msgs::Path * path, bool LogOnErrors = true)
+	{
+		return _bson_path_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *path, LogOnErrors);
 	}
 };
@@ -1,38 +1,68 @@
 #include "ROSGraphMsgsClockConverter.h"
 
 #include "rosgraph_msgs/Clock.h"
+#include "ROSMessageCodec.h"
 #include "Conversion/Messages/BaseMessageConverter.h"
 
 UROSGraphMsgsClockConverter::UROSGraphMsgsClockConverter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
-	_MessageType = "rosgraph_msgs/Clock";
+	_MessageType = TROSMessageCodec<ROSMessages::rosgraph_msgs::Clock>::MessageType();
 }
 
-bool UROSGraphMsgsClockConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+static const TBSONFieldDecoder<ROSMessages::rosgraph_msgs::Clock>& _bson_clock_decoder()
 {
-	auto Clock = new ROSMessages::rosgraph_msgs::Clock();
-	BaseMsg = TSharedPtr<FROSBaseMsg>(Clock);
+	using ROSMessages::rosgraph_msgs::Clock;
+	static const auto Decoder = TBSONFieldDecoder<Clock>()
+		.Field("clock", &Clock::_Clock);
+	return Decoder;
+}
 
-	bool KeyFound = false;
+bool TROSMessageCodec<ROSMessages::rosgraph_msgs::Clock>::Decode(const ROSBridgePublishMsg& message, ROSMessages::rosgraph_msgs::Clock& Msg)
+{
+	return UBaseMessageConverter::DecodeMessage(&message, _bson_clock_decoder(), Msg);
+}
 
-	int32 Sec = GetInt32FromBSON("msg.clock.secs", message->full_msg_bson_, KeyFound);  if (!KeyFound) return false;
-	int32 NSec = GetInt32FromBSON("msg.clock.nsecs", message->full_msg_bson_, KeyFound); if (!KeyFound) return false;
-	Clock->_Clock = FROSTime(Sec, NSec);
+bool TROSMessageCodec<ROSMessages::rosgraph_msgs::Clock>::Append(const ROSMessages::rosgraph_msgs::Clock& Clock, bson_t* message)
+{
+	BCON_APPEND(message,
+		"clock", "{",
+		"secs", BCON_INT32(Clock._Clock._Sec),
+		"nsecs", BCON_INT32(Clock._Clock._NSec),
+		"}"
+	);
 
 	return true;
 }
 
-bool UROSGraphMsgsClockConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool TROSMessageCodec<ROSMessages::rosgraph_msgs::Clock>::WriteTemplateValues(const ROSMessages::rosgraph_msgs::Clock& Clock, FBSONTemplateWriter& Writer)
+{
+	Writer.Int32(Clock._Clock._Sec);
+	Writer.Int32(Clock._Clock._NSec);
+
+	return true;
+}
+
+bool UROSGraphMsgsClockConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+{
+	auto Clock = new ROSMessages::rosgraph_msgs::Clock();
+	BaseMsg = TSharedPtr<FROSBaseMsg>(Clock);
+	return TROSMessageCodec<ROSMessages::rosgraph_msgs::Clock>::Decode(*message, *Clock);
+}
+
+bool UROSGraphMsgsClockConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Clock = StaticCastSharedPtr<ROSMessages::rosgraph_msgs::Clock>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::rosgraph_msgs::Clock>::Append(*Clock, message);
+}
 
-	*message = BCON_NEW(
-		"clock", "{",
-		"secs", BCON_INT32(Clock->_Clock._Sec),
-		"nsecs", BCON_INT32(Clock->_Clock._NSec),
-		"}"
-	);
+bool UROSGraphMsgsClockConverter::WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer)
+{
+	auto Clock = StaticCastSharedPtr<ROSMessages::rosgraph_msgs::Clock>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::rosgraph_msgs::Clock>::WriteTemplateValues(*Clock, Writer);
+}
 
+bool UROSGraphMsgsClockConverter::SupportsTemplate() const
+{
 	return true;
 }
@@ -1,6 +1,7 @@
 #include "Conversion/Messages/sensor_msgs/SensorMsgsCameraInfoConverter.h"
 
 #include "sensor_msgs/CameraInfo.h"
+#include "Conversion/Messages/std_msgs/StdMsgsHeaderConverter.h"
 
 
 USensorMsgsCameraInfoConverter::USensorMsgsCameraInfoConverter(const FObjectInitializer& ObjectInitializer)
@@ -14,7 +15,7 @@ bool USensorMsgsCameraInfoConverter::ConvertIncomingMessage(const ROSBridgePubli
 	return false;
 }
 
-bool USensorMsgsCameraInfoConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message) {
+bool USensorMsgsCameraInfoConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message) {
 
 	auto CameraInfo = StaticCastSharedPtr<ROSMessages::sensor_msgs::CameraInfo>(BaseMsg);
 
@@ -23,7 +24,7 @@ bool USensorMsgsCameraInfoConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseM
 	assert(CameraInfo->R.Num() >= 9);
 	assert(CameraInfo->P.Num() >= 12);
 
-	*message = BCON_NEW(
+	BCON_APPEND(message,
 		"header", "{",
 		"seq", BCON_INT32(CameraInfo->header.seq),
 		"stamp", "{",
@@ -53,3 +54,42 @@ bool USensorMsgsCameraInfoConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseM
 
 	return true;
 }
+
+// The intrinsics of a camera rarely change, so topics publish its CameraInfo by patching the header into the last
+// encoded message. The intrinsics are written as well, which are only a few doubles, so changes are picked up.
+bool USensorMsgsCameraInfoConverter::WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer) {
+
+	auto CameraInfo = StaticCastSharedPtr<ROSMessages::sensor_msgs::CameraInfo>(BaseMsg);
+
+	UStdMsgsHeaderConverter::_bson_write_header(Writer, &(CameraInfo->header));
+	Writer.Int32(CameraInfo->height);
+	Writer.Int32(CameraInfo->width);
+	Writer.String(CameraInfo->distortion_model);
+
+	// only the leading elements are sent, see AppendOutgoingMessage
+	const auto WriteArray = [&Writer](const TArray<double>& Values, int32 Num) {
+		Writer.Array(Num);
+		for (int32 i = 0; i < Num; ++i) {
+			Writer.Double(Values[i]);
+		}
+	};
+	WriteArray(CameraInfo->D, 5);
+	WriteArray(CameraInfo->K, 9);
+	WriteArray(CameraInfo->R, 9);
+	WriteArray(CameraInfo->P, 12);
+
+	Writer.Int32(CameraInfo->binning_x);
+	Writer.Int32(CameraInfo->binning_y);
+	Writer.Int32(CameraInfo->roi.x_offset);
+	Writer.Int32(CameraInfo->roi.y_offset);
+	Writer.Int32(CameraInfo->roi.height);
+	Writer.Int32(CameraInfo->roi.width);
+	Writer.Bool(CameraInfo->roi.do_rectify);
+
+	return true;
+}
+
+bool USensorMsgsCameraInfoConverter::SupportsTemplate() const
+{
+	return true;
+}
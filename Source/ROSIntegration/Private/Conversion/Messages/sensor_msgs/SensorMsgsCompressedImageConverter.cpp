@@ -11,14 +11,14 @@ bool USensorMsgsCompressedImageConverter::ConvertIncomingMessage(const ROSBridge
 {
 	auto p = new ROSMessages::sensor_msgs::CompressedImage;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_image(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_compressed_image_decoder(), *p);
 }
 
-bool USensorMsgsCompressedImageConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool USensorMsgsCompressedImageConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Image = StaticCastSharedPtr<ROSMessages::sensor_msgs::CompressedImage>(BaseMsg);
 
-	*message = BCON_NEW(
+	BCON_APPEND(message,
 		"header", "{",
 		"seq", BCON_INT32(Image->header.seq),
 		"stamp", "{",
@@ -29,6 +29,6 @@ bool USensorMsgsCompressedImageConverter::ConvertOutgoingMessage(TSharedPtr<FROS
 		"}",
 		"format", BCON_UTF8(TCHAR_TO_UTF8(*Image->format))
 	);
-	bson_append_binary(*message, "data", -1, BSON_SUBTYPE_BINARY, Image->data, Image->data_size);
+	bson_append_binary(message, "data", -1, BSON_SUBTYPE_BINARY, Image->data, Image->data_size);
 	return true;
 }
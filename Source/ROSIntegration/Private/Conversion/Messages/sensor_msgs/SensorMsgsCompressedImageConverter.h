@@ -18,19 +18,25 @@ class ROSINTEGRATION_API USensorMsgsCompressedImageConverter : public UBaseMessa
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_image(bson_t *b, FString key, ROSMessages::sensor_msgs::CompressedImage *img)
+	static const TBSONFieldDecoder<ROSMessages::sensor_msgs::CompressedImage>& _bson_compressed_image_decoder()
 	{
-		bool KeyFound = false;
-
-		KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(b, TEXT("msg.header"), &img->header); if (!KeyFound) return false;
-
-		img->format = GetFStringFromBSON(key + ".format", b, KeyFound); if (!KeyFound) return false;
-
-		uint32_t binSize = 0;
-		img->data = rosbridge2cpp::Helper::get_binary_by_key(TCHAR_TO_UTF8(*(key + ".data")), *b, binSize, KeyFound);
+		using ROSMessages::sensor_msgs::CompressedImage;
+		static const auto Decoder = TBSONFieldDecoder<CompressedImage>()
+			.Field("header", &CompressedImage::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+			.Field("format", &CompressedImage::format)
+			.Field("data", [](const bson_iter_t& Iter, CompressedImage& img) {
+				uint32_t Length = 0;
+				if (!FBSONValueReader::ReadBinary(Iter, img.data, Length)) return false;
+				img.data_size = Length;
+				return true;
+			});
+		return Decoder;
+	}
 
-		return KeyFound;
+	static bool _bson_extract_child_image(bson_t *b, FString key, ROSMessages::sensor_msgs::CompressedImage *img)
+	{
+		return _bson_compressed_image_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *img);
 	}
 };
@@ -11,14 +11,14 @@ bool USensorMsgsImageConverter::ConvertIncomingMessage(const ROSBridgePublishMsg
 {
 	auto p = new ROSMessages::sensor_msgs::Image;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_image(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_image_decoder(), *p);
 }
 
-bool USensorMsgsImageConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool USensorMsgsImageConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Image = StaticCastSharedPtr<ROSMessages::sensor_msgs::Image>(BaseMsg);
 
-	*message = BCON_NEW(
+	BCON_APPEND(message,
 	"header", "{",
 	"seq", BCON_INT32(Image->header.seq),
 	"stamp", "{",
@@ -32,6 +32,8 @@ bool USensorMsgsImageConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> B
 	"encoding", BCON_UTF8(TCHAR_TO_UTF8(*Image->encoding)),
 	"step", BCON_INT32(Image->step)
 	);
-	bson_append_binary(*message, "data", -1, BSON_SUBTYPE_BINARY, Image->data, Image->height * Image->step );
-	return true;
+	if (Image->data_buffer.IsValid()) {
+		return _bson_append_shared_binary(message, "data", Image->data_buffer, Image->height * Image->step);
+	}
+	return bson_append_binary(message, "data", -1, BSON_SUBTYPE_BINARY, Image->data, Image->height * Image->step);
 }
@@ -18,23 +18,24 @@ class ROSINTEGRATION_API USensorMsgsImageConverter: public UBaseMessageConverter
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_image(bson_t *b, FString key, ROSMessages::sensor_msgs::Image *img)
+	static const TBSONFieldDecoder<ROSMessages::sensor_msgs::Image>& _bson_image_decoder()
 	{
-		bool KeyFound = false;
-
-		KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(b, TEXT("msg.header"), &img->header); if (!KeyFound) return false;
-
-		img->height = GetInt32FromBSON(key + ".height", b, KeyFound); if (!KeyFound) return false;
-		img->width = GetInt32FromBSON(key + ".width", b, KeyFound); if (!KeyFound) return false;
-		img->encoding = GetFStringFromBSON(key + ".encoding", b, KeyFound); if (!KeyFound) return false;
-		img->is_bigendian = GetInt32FromBSON(key + ".is_bigendian", b, KeyFound); if (!KeyFound) return false;
-		img->step = GetInt32FromBSON(key + ".step", b, KeyFound); if (!KeyFound) return false;
-
-		uint32_t binSize = 0;
-		img->data = rosbridge2cpp::Helper::get_binary_by_key(TCHAR_TO_UTF8(*(key + ".data")), *b, binSize, KeyFound);
+		using ROSMessages::sensor_msgs::Image;
+		static const auto Decoder = TBSONFieldDecoder<Image>()
+			.Field("header", &Image::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+			.Field("height", &Image::height)
+			.Field("width", &Image::width)
+			.Field("encoding", &Image::encoding)
+			.Field("is_bigendian", &Image::is_bigendian)
+			.Field("step", &Image::step)
+			.Field("data", &Image::data);
+		return Decoder;
+	}
 
-		return KeyFound;
+	static bool _bson_extract_child_image(bson_t *b, FString key, ROSMessages::sensor_msgs::Image *img)
+	{
+		return _bson_image_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *img);
 	}
 };
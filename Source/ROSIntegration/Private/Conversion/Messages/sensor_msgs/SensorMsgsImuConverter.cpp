@@ -1,6 +1,7 @@
 #include "Conversion/Messages/sensor_msgs/SensorMsgsImuConverter.h"
 
 #include "sensor_msgs/Imu.h"
+#include "ROSMessageCodec.h"
 #include "Conversion/Messages/std_msgs/StdMsgsHeaderConverter.h"
 #include "Conversion/Messages/geometry_msgs/GeometryMsgsQuaternionConverter.h"
 #include "Conversion/Messages/geometry_msgs/GeometryMsgsVector3Converter.h"
@@ -10,58 +11,78 @@
 USensorMsgsImuConverter::USensorMsgsImuConverter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	_MessageType = "sensor_msgs/Imu";
+	_MessageType = TROSMessageCodec<ROSMessages::sensor_msgs::Imu>::MessageType();
 }
 
-bool USensorMsgsImuConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+static const TBSONFieldDecoder<ROSMessages::sensor_msgs::Imu>& _bson_imu_decoder()
 {
-	auto i = new ROSMessages::sensor_msgs::Imu();
-	BaseMsg = TSharedPtr<FROSBaseMsg>(i);
+	using ROSMessages::sensor_msgs::Imu;
+	static const auto Decoder = TBSONFieldDecoder<Imu>()
+		.Field("header", &Imu::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+		.Field("orientation", &Imu::orientation, UGeometryMsgsQuaternionConverter::_bson_quaternion_decoder())
+		.Field("orientation_covariance", &Imu::orientation_covariance)
+		.Field("angular_velocity", &Imu::angular_velocity, UGeometryMsgsVector3Converter::_bson_vector3_decoder())
+		.Field("angular_velocity_covariance", &Imu::angular_velocity_covariance)
+		.Field("linear_acceleration", &Imu::linear_acceleration, UGeometryMsgsVector3Converter::_bson_vector3_decoder())
+		.Field("linear_acceleration_covariance", &Imu::linear_acceleration_covariance)
+		.Validate([](const Imu& i) {
+			// Size of covariance, 3x3 -> array of 9 see ROS IMU msg definition at above link
+			return i.orientation_covariance.Num() == 9 && i.angular_velocity_covariance.Num() == 9 && i.linear_acceleration_covariance.Num() == 9;
+		});
+	return Decoder;
+}
+
+bool TROSMessageCodec<ROSMessages::sensor_msgs::Imu>::Decode(const ROSBridgePublishMsg& message, ROSMessages::sensor_msgs::Imu& Msg)
+{
+	return UBaseMessageConverter::DecodeMessage(&message, _bson_imu_decoder(), Msg);
+}
 
-	bool KeyFound = false;
-	KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(message->full_msg_bson_, TEXT("msg.header"), &i->header);
-	if (!KeyFound) return false;
+bool TROSMessageCodec<ROSMessages::sensor_msgs::Imu>::Append(const ROSMessages::sensor_msgs::Imu& Imu, bson_t* message)
+{
+	UStdMsgsHeaderConverter::_bson_append_header(message, &(Imu.header));
 
-	KeyFound = UGeometryMsgsQuaternionConverter::_bson_extract_child_quaternion(message->full_msg_bson_, TEXT("msg.orientation"), &i->orientation);
-	if (!KeyFound) return false;
-	
-	i->orientation_covariance = GetDoubleTArrayFromBSON("msg.orientation_covariance", message->full_msg_bson_, KeyFound);
-	if (!KeyFound || i->orientation_covariance.Num() != 9) // Size of covariance, 3x3 -> array of 9 see ROS IMU msg definition at above link
-		return false;
-	
-	KeyFound = UGeometryMsgsVector3Converter::_bson_extract_child_vector3(message->full_msg_bson_, "msg.angular_velocity",&i->angular_velocity);
-	if (!KeyFound) return false;
+	UGeometryMsgsQuaternionConverter::_bson_append_child_quaternion(message, "orientation", &(Imu.orientation));
+	if (!UBaseMessageConverter::_bson_append_double_tarray(message, "orientation_covariance", Imu.orientation_covariance)) return false;
+	UGeometryMsgsVector3Converter::_bson_append_child_vector3(message, "angular_velocity", &(Imu.angular_velocity));
+	if (!UBaseMessageConverter::_bson_append_double_tarray(message, "angular_velocity_covariance", Imu.angular_velocity_covariance)) return false;
+	UGeometryMsgsVector3Converter::_bson_append_child_vector3(message, "linear_acceleration", &(Imu.linear_acceleration));
+	return UBaseMessageConverter::_bson_append_double_tarray(message, "linear_acceleration_covariance", Imu.linear_acceleration_covariance);
+}
 
-	i->angular_velocity_covariance = GetDoubleTArrayFromBSON("msg.angular_velocity_covariance", message->full_msg_bson_, KeyFound);
-	if (!KeyFound || i->angular_velocity_covariance.Num() != 9) // Size of covariance, 3x3 -> array of 9 see ROS IMU msg definition at above link
-		return false;
+bool TROSMessageCodec<ROSMessages::sensor_msgs::Imu>::WriteTemplateValues(const ROSMessages::sensor_msgs::Imu& Imu, FBSONTemplateWriter& Writer)
+{
+	UStdMsgsHeaderConverter::_bson_write_header(Writer, &(Imu.header));
 
-	KeyFound = UGeometryMsgsVector3Converter::_bson_extract_child_vector3(message->full_msg_bson_, "msg.linear_acceleration",&i->linear_acceleration);
-	if (!KeyFound) return false;
+	UGeometryMsgsQuaternionConverter::_bson_write_quaternion(Writer, &(Imu.orientation));
+	Writer.DoubleArray(Imu.orientation_covariance);
+	UGeometryMsgsVector3Converter::_bson_write_vector3(Writer, &(Imu.angular_velocity));
+	Writer.DoubleArray(Imu.angular_velocity_covariance);
+	UGeometryMsgsVector3Converter::_bson_write_vector3(Writer, &(Imu.linear_acceleration));
+	Writer.DoubleArray(Imu.linear_acceleration_covariance);
 
-	i->linear_acceleration_covariance = GetDoubleTArrayFromBSON("msg.linear_acceleration_covariance", message->full_msg_bson_, KeyFound);
-	if (!KeyFound || i->linear_acceleration_covariance.Num() != 9) // Size of covariance, 3x3 -> array of 9 see ROS IMU msg definition at above link
-		return false;
-		
 	return true;
 }
 
-bool USensorMsgsImuConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool USensorMsgsImuConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
 {
-	auto Imu = StaticCastSharedPtr<ROSMessages::sensor_msgs::Imu>(BaseMsg);
-
-	*message = new bson_t;
-	bson_init(*message);
+	auto i = new ROSMessages::sensor_msgs::Imu();
+	BaseMsg = TSharedPtr<FROSBaseMsg>(i);
+	return TROSMessageCodec<ROSMessages::sensor_msgs::Imu>::Decode(*message, *i);
+}
 
-	UStdMsgsHeaderConverter::_bson_append_header(*message, &(Imu->header));
+bool USensorMsgsImuConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
+{
+	auto Imu = StaticCastSharedPtr<ROSMessages::sensor_msgs::Imu>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::sensor_msgs::Imu>::Append(*Imu, message);
+}
 
-	UGeometryMsgsQuaternionConverter::_bson_append_child_quaternion(*message, "orientation", &(Imu->orientation));
-	_bson_append_double_tarray(*message, "orientation_covariance", Imu->orientation_covariance);
-	UGeometryMsgsVector3Converter::_bson_append_child_vector3(*message, "angular_velocity", &(Imu->angular_velocity));
-	_bson_append_double_tarray(*message, "angular_velocity_covariance", Imu->orientation_covariance);
-	UGeometryMsgsVector3Converter::_bson_append_child_vector3(*message, "linear_acceleration", &(Imu->linear_acceleration));
-	_bson_append_double_tarray(*message, "linear_acceleration_covariance", Imu->linear_acceleration_covariance);
+bool USensorMsgsImuConverter::WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer)
+{
+	auto Imu = StaticCastSharedPtr<ROSMessages::sensor_msgs::Imu>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::sensor_msgs::Imu>::WriteTemplateValues(*Imu, Writer);
+}
 
+bool USensorMsgsImuConverter::SupportsTemplate() const
+{
 	return true;
 }
-
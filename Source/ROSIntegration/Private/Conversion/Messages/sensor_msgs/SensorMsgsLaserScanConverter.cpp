@@ -10,17 +10,13 @@ bool USensorMsgsLaserScanConverter::ConvertIncomingMessage(const ROSBridgePublis
 {
 	auto p = new ROSMessages::sensor_msgs::LaserScan;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_laser_scan(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_laser_scan_decoder(), *p);
 }
 
-bool USensorMsgsLaserScanConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool USensorMsgsLaserScanConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto mad = StaticCastSharedPtr<ROSMessages::sensor_msgs::LaserScan>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_laser_scan(*message, mad.Get());
-
-	return true;
+	return _bson_append_laser_scan(message, mad.Get());
 }
 
@@ -17,37 +17,40 @@ class ROSINTEGRATION_API USensorMsgsLaserScanConverter : public UBaseMessageConv
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_laser_scan(bson_t *b, FString key, ROSMessages::sensor_msgs::LaserScan *ls, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::sensor_msgs::LaserScan>& _bson_laser_scan_decoder()
 	{
-		bool KeyFound = false;
-
-		KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(b, key + ".header", &ls->header); if (!KeyFound) return false;
-
-		ls->angle_min		= (float)GetDoubleFromBSON(key + ".angle_min", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		ls->angle_max		= (float)GetDoubleFromBSON(key + ".angle_max", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		ls->angle_increment	= (float)GetDoubleFromBSON(key + ".angle_increment", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		ls->time_increment	= (float)GetDoubleFromBSON(key + ".time_increment", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		ls->scan_time		= (float)GetDoubleFromBSON(key + ".scan_time", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		ls->range_min		= (float)GetDoubleFromBSON(key + ".range_min", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		ls->range_max		= (float)GetDoubleFromBSON(key + ".range_max", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-
-		ls->ranges = GetFloatTArrayFromBSON(key + ".ranges", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		ls->intensities = GetFloatTArrayFromBSON(key + ".intensities", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
+		using ROSMessages::sensor_msgs::LaserScan;
+		static const auto Decoder = TBSONFieldDecoder<LaserScan>()
+			.Field("header", &LaserScan::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+			.Field("angle_min", &LaserScan::angle_min)
+			.Field("angle_max", &LaserScan::angle_max)
+			.Field("angle_increment", &LaserScan::angle_increment)
+			.Field("time_increment", &LaserScan::time_increment)
+			.Field("scan_time", &LaserScan::scan_time)
+			.Field("range_min", &LaserScan::range_min)
+			.Field("range_max", &LaserScan::range_max)
+			.Field("ranges", &LaserScan::ranges)
+			.Field("intensities", &LaserScan::intensities);
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_laser_scan(bson_t *b, FString key, ROSMessages::sensor_msgs::LaserScan *ls, bool LogOnErrors = true)
+	{
+		return _bson_laser_scan_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *ls, LogOnErrors);
 	}
 
-	static void _bson_append_child_laser_scan(bson_t *b, const char *key, const ROSMessages::sensor_msgs::LaserScan *ls)
+	static bool _bson_append_child_laser_scan(bson_t *b, const char *key, const ROSMessages::sensor_msgs::LaserScan *ls)
 	{
 		bson_t layout;
 		BSON_APPEND_DOCUMENT_BEGIN(b, key, &layout);
-		_bson_append_laser_scan(&layout, ls);
+		const bool bAppended = _bson_append_laser_scan(&layout, ls);
 		bson_append_document_end(b, &layout);
+		return bAppended;
 	}
 
-	static void _bson_append_laser_scan(bson_t *b, const ROSMessages::sensor_msgs::LaserScan *ls)
+	static bool _bson_append_laser_scan(bson_t *b, const ROSMessages::sensor_msgs::LaserScan *ls)
 	{
 		UStdMsgsHeaderConverter::_bson_append_header(b, &ls->header);
 
@@ -59,7 +62,7 @@ public:
 		BSON_APPEND_DOUBLE(b, "range_min", ls->range_min);
 		BSON_APPEND_DOUBLE(b, "range_max", ls->range_max);
 
-		_bson_append_float_tarray(b, "ranges", ls->ranges);
-		_bson_append_float_tarray(b, "intensities", ls->intensities);
+		return _bson_append_float_tarray(b, "ranges", ls->ranges)
+			&& _bson_append_float_tarray(b, "intensities", ls->intensities);
 	}
 };
@@ -10,51 +10,39 @@ USensorMsgsNavSatFixConverter::USensorMsgsNavSatFixConverter(const FObjectInitia
 	_MessageType = "sensor_msgs/NavSatFix";
 }
 
+static const TBSONFieldDecoder<ROSMessages::sensor_msgs::NavSatFix>& _bson_nav_sat_fix_decoder()
+{
+	using ROSMessages::sensor_msgs::NavSatFix;
+	static const auto Decoder = TBSONFieldDecoder<NavSatFix>()
+		.Field("header", &NavSatFix::header, UStdMsgsHeaderConverter::_bson_header_decoder())
+		.Field("status", &NavSatFix::status, USensorMsgsNavSatStatusConverter::_bson_nav_sat_status_decoder())
+		.Field("latitude", &NavSatFix::latitude)
+		.Field("longitude", &NavSatFix::longitude)
+		.Field("altitude", &NavSatFix::altitude)
+		.Field("position_covariance", &NavSatFix::position_covariance)
+		.Field("position_covariance_type", &NavSatFix::position_covariance_type)
+		.Validate([](const NavSatFix& nsf) { return nsf.position_covariance.Num() == 9; }); // Covariance is a 3x3 matrix, so we should have 9 elements.
+	return Decoder;
+}
+
 bool USensorMsgsNavSatFixConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
 {
 	auto nsf = new ROSMessages::sensor_msgs::NavSatFix();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(nsf);
-
-	bool KeyFound = false;
-	KeyFound = UStdMsgsHeaderConverter::_bson_extract_child_header(message->full_msg_bson_, "msg.header", &(nsf->header));
-	if (!KeyFound) return false;
-
-	KeyFound = USensorMsgsNavSatStatusConverter::_bson_extract_child_nav_sat_status(message->full_msg_bson_, "msg.status", &(nsf->status));
-	if (!KeyFound) return false;
-
-	nsf->latitude = GetDoubleFromBSON("msg.latitude", message->full_msg_bson_, KeyFound);
-	if (!KeyFound) return false;
-
-	nsf->longitude = GetDoubleFromBSON("msg.longitude", message->full_msg_bson_, KeyFound);
-	if (!KeyFound) return false;
-
-	nsf->altitude = GetDoubleFromBSON("msg.altitude", message->full_msg_bson_, KeyFound);
-	if (!KeyFound) return false;
-
-	nsf->position_covariance = GetDoubleTArrayFromBSON("msg.position_covariance", message->full_msg_bson_, KeyFound);
-	if (!KeyFound || nsf->position_covariance.Num() != 9) // Covariance is a 3x3 matrix, so we should have 9 elements.
-		return false;
-
-	nsf->position_covariance_type = static_cast<ROSMessages::sensor_msgs::NavSatFix::CovarianceType>(GetInt32FromBSON("msg.position_covariance_type", message->full_msg_bson_, KeyFound));
-	if (!KeyFound) return false;
-
-	return true;
+	return DecodeMessage(message, _bson_nav_sat_fix_decoder(), *nsf);
 }
 
-bool USensorMsgsNavSatFixConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool USensorMsgsNavSatFixConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto nsf = StaticCastSharedPtr<ROSMessages::sensor_msgs::NavSatFix>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-
-	UStdMsgsHeaderConverter::_bson_append_header(*message, &(nsf->header));
-	USensorMsgsNavSatStatusConverter::_bson_append_child_nav_sat_status(*message, "status", &(nsf->status));
-	BSON_APPEND_DOUBLE(*message, "latitude", nsf->latitude);
-	BSON_APPEND_DOUBLE(*message, "longitude", nsf->longitude);
-	BSON_APPEND_DOUBLE(*message, "altitude", nsf->altitude);
-	_bson_append_double_tarray(*message, "position_covariance", nsf->position_covariance);
-	BSON_APPEND_INT32(*message, "position_covariance_type", nsf->position_covariance_type);
+	UStdMsgsHeaderConverter::_bson_append_header(message, &(nsf->header));
+	USensorMsgsNavSatStatusConverter::_bson_append_child_nav_sat_status(message, "status", &(nsf->status));
+	BSON_APPEND_DOUBLE(message, "latitude", nsf->latitude);
+	BSON_APPEND_DOUBLE(message, "longitude", nsf->longitude);
+	BSON_APPEND_DOUBLE(message, "altitude", nsf->altitude);
+	if (!_bson_append_double_tarray(message, "position_covariance", nsf->position_covariance)) return false;
+	BSON_APPEND_INT32(message, "position_covariance_type", nsf->position_covariance_type);
 
 	return true;
 }
@@ -10,16 +10,14 @@ bool USensorMsgsNavSatStatusConverter::ConvertIncomingMessage(const ROSBridgePub
 {
 	auto nss = new ROSMessages::sensor_msgs::NavSatStatus();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(nss);
-	return _bson_extract_child_nav_sat_status(message->full_msg_bson_, "msg", nss);
+	return DecodeMessage(message, _bson_nav_sat_status_decoder(), *nss);
 }
 
-bool USensorMsgsNavSatStatusConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool USensorMsgsNavSatStatusConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto nss = StaticCastSharedPtr<ROSMessages::sensor_msgs::NavSatStatus>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_nav_sat_status(*message, nss.Get());
+	_bson_append_nav_sat_status(message, nss.Get());
 
 	return true;
 }
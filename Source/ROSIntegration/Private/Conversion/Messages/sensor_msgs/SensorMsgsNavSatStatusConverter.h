@@ -15,19 +15,20 @@ class ROSINTEGRATION_API USensorMsgsNavSatStatusConverter : public UBaseMessageC
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_nav_sat_status(bson_t* b, FString key, ROSMessages::sensor_msgs::NavSatStatus* nss, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::sensor_msgs::NavSatStatus>& _bson_nav_sat_status_decoder()
 	{
-		bool KeyFound = false;
-
-		nss->status = static_cast<ROSMessages::sensor_msgs::NavSatStatus::Status>(GetInt32FromBSON(key + ".status", b, KeyFound, LogOnErrors));
-		if (!KeyFound) return false;
-
-		nss->service = static_cast<ROSMessages::sensor_msgs::NavSatStatus::Service>(GetInt32FromBSON(key + ".service", b, KeyFound, LogOnErrors));
-		if (!KeyFound) return false;
+		using ROSMessages::sensor_msgs::NavSatStatus;
+		static const auto Decoder = TBSONFieldDecoder<NavSatStatus>()
+			.Field("status", &NavSatStatus::status)
+			.Field("service", &NavSatStatus::service);
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_nav_sat_status(bson_t* b, FString key, ROSMessages::sensor_msgs::NavSatStatus* nss, bool LogOnErrors = true)
+	{
+		return _bson_nav_sat_status_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *nss, LogOnErrors);
 	}
 
 	static void _bson_append_child_nav_sat_status(bson_t* b, const char *key, ROSMessages::sensor_msgs::NavSatStatus* nss)
@@ -14,7 +14,7 @@ bool USensorMsgsRegionOfInterestConverter::ConvertIncomingMessage(const ROSBridg
 	return false;
 }
 
-bool USensorMsgsRegionOfInterestConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message) {
+bool USensorMsgsRegionOfInterestConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message) {
 	UE_LOG(LogROS, Warning, TEXT("ROSIntegration: RegionOfInterest sending not implemented yet"));
 	return false;
 }
@@ -1,26 +1,60 @@
 #include "Conversion/Messages/std_msgs/StdMsgsFloat32Converter.h"
 
+#include "ROSMessageCodec.h"
+
 
 UStdMsgsFloat32Converter::UStdMsgsFloat32Converter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
-	_MessageType = "std_msgs/Float32";
+	_MessageType = TROSMessageCodec<ROSMessages::std_msgs::Float32>::MessageType();
 }
 
-bool UStdMsgsFloat32Converter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg) {
-	bool KeyFound = false;
+static const TBSONFieldDecoder<ROSMessages::std_msgs::Float32>& _bson_float32_decoder()
+{
+	using ROSMessages::std_msgs::Float32;
+	static const auto Decoder = TBSONFieldDecoder<Float32>()
+		.Field("data", &Float32::_Data);
+	return Decoder;
+}
 
-	float Data = (float)GetDoubleFromBSON(TEXT("msg.data"), message->full_msg_bson_, KeyFound);
-	if (!KeyFound) return false;
+bool TROSMessageCodec<ROSMessages::std_msgs::Float32>::Decode(const ROSBridgePublishMsg& message, ROSMessages::std_msgs::Float32& Msg)
+{
+	return UBaseMessageConverter::DecodeMessage(&message, _bson_float32_decoder(), Msg);
+}
 
-	BaseMsg = TSharedPtr<FROSBaseMsg>(new ROSMessages::std_msgs::Float32(Data));
+bool TROSMessageCodec<ROSMessages::std_msgs::Float32>::Append(const ROSMessages::std_msgs::Float32& Msg, bson_t* message)
+{
+	BCON_APPEND(message,
+		"data", BCON_DOUBLE(Msg._Data)
+	);
+	return true;
+}
+
+bool TROSMessageCodec<ROSMessages::std_msgs::Float32>::WriteTemplateValues(const ROSMessages::std_msgs::Float32& Msg, FBSONTemplateWriter& Writer)
+{
+	Writer.Double(Msg._Data);
 	return true;
 }
 
-bool UStdMsgsFloat32Converter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message) {
+bool UStdMsgsFloat32Converter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+{
+	auto p = new ROSMessages::std_msgs::Float32;
+	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
+	return TROSMessageCodec<ROSMessages::std_msgs::Float32>::Decode(*message, *p);
+}
+
+bool UStdMsgsFloat32Converter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message) {
 	auto Float32Message = StaticCastSharedPtr<ROSMessages::std_msgs::Float32>(BaseMsg);
-	*message = BCON_NEW(
-		"data", BCON_DOUBLE(Float32Message->_Data)
-	);
+	return TROSMessageCodec<ROSMessages::std_msgs::Float32>::Append(*Float32Message, message);
+}
+
+bool UStdMsgsFloat32Converter::WriteTemplateValues(TSharedPtr<FROSBaseMsg> BaseMsg, FBSONTemplateWriter& Writer)
+{
+	auto Float32Message = StaticCastSharedPtr<ROSMessages::std_msgs::Float32>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::std_msgs::Float32>::WriteTemplateValues(*Float32Message, Writer);
+}
+
+bool UStdMsgsFloat32Converter::SupportsTemplate() const
+{
 	return true;
 }
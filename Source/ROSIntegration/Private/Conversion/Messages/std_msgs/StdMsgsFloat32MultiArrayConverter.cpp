@@ -10,16 +10,12 @@ bool UStdMsgsFloat32MultiArrayConverter::ConvertIncomingMessage(const ROSBridgeP
 {
 	auto p = new ROSMessages::std_msgs::Float32MultiArray;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_float_multi_array(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_float_multi_array_decoder(), *p);
 }
 
-bool UStdMsgsFloat32MultiArrayConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UStdMsgsFloat32MultiArrayConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto mad = StaticCastSharedPtr<ROSMessages::std_msgs::Float32MultiArray>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_float_multi_array(*message, mad.Get());
-
-	return true;
+	return _bson_append_float_multi_array(message, mad.Get());
 }
@@ -17,29 +17,34 @@ class ROSINTEGRATION_API UStdMsgsFloat32MultiArrayConverter : public UBaseMessag
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_float_multi_array(bson_t *b, FString key, ROSMessages::std_msgs::Float32MultiArray *fma, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::std_msgs::Float32MultiArray>& _bson_float_multi_array_decoder()
 	{
-		bool KeyFound = false;
-
-		KeyFound = UStdMsgsMultiArrayLayoutConverter::_bson_extract_child_multi_array_layout(b, key + ".layout", &fma->layout, LogOnErrors); if (!KeyFound) return false;
-		fma->data = GetFloatTArrayFromBSON(key + ".data", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
+		using ROSMessages::std_msgs::Float32MultiArray;
+		static const auto Decoder = TBSONFieldDecoder<Float32MultiArray>()
+			.Field("layout", &Float32MultiArray::layout, UStdMsgsMultiArrayLayoutConverter::_bson_multi_array_layout_decoder())
+			.Field("data", &Float32MultiArray::data);
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_float_multi_array(bson_t *b, FString key, ROSMessages::std_msgs::Float32MultiArray *fma, bool LogOnErrors = true)
+	{
+		return _bson_float_multi_array_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *fma, LogOnErrors);
 	}
 
-	static void _bson_append_child_float_multi_array(bson_t *b, const char *key, const ROSMessages::std_msgs::Float32MultiArray *fma)
+	static bool _bson_append_child_float_multi_array(bson_t *b, const char *key, const ROSMessages::std_msgs::Float32MultiArray *fma)
 	{
 		bson_t layout;
 		BSON_APPEND_DOCUMENT_BEGIN(b, key, &layout);
-		_bson_append_float_multi_array(&layout, fma);
+		const bool bAppended = _bson_append_float_multi_array(&layout, fma);
 		bson_append_document_end(b, &layout);
+		return bAppended;
 	}
 
-	static void _bson_append_float_multi_array(bson_t *b, const ROSMessages::std_msgs::Float32MultiArray *fma)
+	static bool _bson_append_float_multi_array(bson_t *b, const ROSMessages::std_msgs::Float32MultiArray *fma)
 	{
 		UStdMsgsMultiArrayLayoutConverter::_bson_append_child_multi_array_layout(b, "layout", &fma->layout);
-		_bson_append_float_tarray(b, "data", fma->data);
+		return _bson_append_float_tarray(b, "data", fma->data);
 	}
 };
@@ -2,6 +2,26 @@
 
 #include "std_msgs/Header.h"
 
+namespace
+{
+	struct FFrameIdCache
+	{
+		struct FEntry
+		{
+			FString FrameId;
+			TArray<ANSICHAR> UTF8;
+		};
+
+		// publishers on the same thread, e.g. the game thread, mostly use a handful of frames
+		static const int32 MaxEntries = 16;
+
+		TArray<FEntry> Entries;
+		int32 NextReplaced = 0;
+		uint64 NumConversions = 0;
+	};
+
+	thread_local FFrameIdCache FrameIdCache;
+}
 
 UStdMsgsHeaderConverter::UStdMsgsHeaderConverter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -13,21 +33,47 @@ bool UStdMsgsHeaderConverter::ConvertIncomingMessage(const ROSBridgePublishMsg*
 {
 	auto p = new ROSMessages::std_msgs::Header();
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_header(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_header_decoder(), *p);
 }
 
-bool UStdMsgsHeaderConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UStdMsgsHeaderConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto h = StaticCastSharedPtr<ROSMessages::std_msgs::Header>(BaseMsg);
 
-	*message = BCON_NEW(
-		"seq", BCON_INT32(h->seq),
-		"stamp", "{",
-		"secs", BCON_INT32(h->time._Sec),
-		"nsecs", BCON_INT32(h->time._NSec),
-		"}",
-		"frame_id", BCON_UTF8(TCHAR_TO_ANSI(*h->frame_id))
-	);
+	_bson_append_header_fields(message, h.Get());
 
 	return true;
 }
+
+const TArray<ANSICHAR>& UStdMsgsHeaderConverter::_utf8_frame_id(const FString& FrameId)
+{
+	FFrameIdCache& Cache = FrameIdCache;
+
+	// frame_ids are case-sensitive, the default FString comparison is not
+	for (const FFrameIdCache::FEntry& Entry : Cache.Entries) {
+		if (Entry.FrameId.Equals(FrameId, ESearchCase::CaseSensitive)) {
+			return Entry.UTF8;
+		}
+	}
+
+	FFrameIdCache::FEntry* Entry;
+	if (Cache.Entries.Num() < FFrameIdCache::MaxEntries) {
+		Entry = &Cache.Entries[Cache.Entries.AddDefaulted()];
+	}
+	else {
+		Entry = &Cache.Entries[Cache.NextReplaced];
+		Cache.NextReplaced = (Cache.NextReplaced + 1) % FFrameIdCache::MaxEntries;
+	}
+
+	const FTCHARToUTF8 Converted(*FrameId);
+	Entry->FrameId = FrameId;
+	Entry->UTF8.Reset();
+	Entry->UTF8.Append(Converted.Get(), Converted.Length());
+	++Cache.NumConversions;
+	return Entry->UTF8;
+}
+
+uint64 UStdMsgsHeaderConverter::_num_frame_id_conversions()
+{
+	return FrameIdCache.NumConversions;
+}
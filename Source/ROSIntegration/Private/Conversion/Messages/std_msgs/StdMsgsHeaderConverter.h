@@ -1,48 +1,79 @@
-#pragma once
-
-#include <CoreMinimal.h>
-#include <UObject/ObjectMacros.h>
-#include <UObject/Object.h>
-#include "Conversion/Messages/BaseMessageConverter.h"
-
-#include "StdMsgsHeaderConverter.generated.h"
-
-
-UCLASS()
-class ROSINTEGRATION_API UStdMsgsHeaderConverter: public UBaseMessageConverter
-{
-	GENERATED_UCLASS_BODY()
-
-public:
-	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
-
-	// Helper function to extract a child-std_msgs/Header from a bson_t
-	static bool _bson_extract_child_header(bson_t *b, FString key, ROSMessages::std_msgs::Header *h, bool LogOnErrors = true)
-	{
-		bool KeyFound = false;
-		
-		// TODO Check if rosbridge sends UINT64 or INT32 (there is no uint32 in bson)
-		h->seq =	  GetInt32FromBSON(key + ".seq", b, KeyFound, LogOnErrors);		if (!KeyFound) return false;
-		int32 Sec =   GetInt32FromBSON(key + ".stamp.secs", b, KeyFound, LogOnErrors);  if (!KeyFound) return false;
-		int32 NSec =  GetInt32FromBSON(key + ".stamp.nsecs", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		h->frame_id = GetFStringFromBSON(key + ".frame_id", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		h->time = FROSTime(Sec, NSec);
-
-		return true;
-	}
-
-	// Helper function to append a std_msgs/Header to a bson_t
-	static void _bson_append_header(bson_t *b, const ROSMessages::std_msgs::Header *h)
-	{
-		bson_t *hdr = BCON_NEW(
-			"seq", BCON_INT32(h->seq),
-			"stamp", "{",
-			"secs", BCON_INT32(h->time._Sec),
-			"nsecs", BCON_INT32(h->time._NSec),
-			"}",
-			"frame_id", BCON_UTF8(TCHAR_TO_ANSI(*h->frame_id))
-		);
-		BSON_APPEND_DOCUMENT(b, "header", hdr);
-	}
-};
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/ObjectMacros.h>
+#include <UObject/Object.h>
+#include "Conversion/Messages/BaseMessageConverter.h"
+
+#include "StdMsgsHeaderConverter.generated.h"
+
+
+UCLASS()
+class ROSINTEGRATION_API UStdMsgsHeaderConverter: public UBaseMessageConverter
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
+
+	// Helper function to extract a child-std_msgs/Header from a bson_t
+	static const TBSONFieldDecoder<ROSMessages::std_msgs::Header>& _bson_header_decoder()
+	{
+		using ROSMessages::std_msgs::Header;
+		static const auto Decoder = TBSONFieldDecoder<Header>()
+			.Field("seq", &Header::seq)
+			.Field("stamp", &Header::time)
+			.Field("frame_id", &Header::frame_id);
+		return Decoder;
+	}
+
+	static bool _bson_extract_child_header(bson_t *b, FString key, ROSMessages::std_msgs::Header *h, bool LogOnErrors = true)
+	{
+		return _bson_header_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *h, LogOnErrors);
+	}
+
+	// Helper function to append a std_msgs/Header to a bson_t.
+	// The header is written in place into b, and frame_id is taken from the cache of _utf8_frame_id,
+	// so this doesn't allocate unless b has to grow.
+	static void _bson_append_header(bson_t *b, const ROSMessages::std_msgs::Header *h)
+	{
+		bson_t hdr;
+		BSON_APPEND_DOCUMENT_BEGIN(b, "header", &hdr);
+		_bson_append_header_fields(&hdr, h);
+		bson_append_document_end(b, &hdr);
+	}
+
+	static void _bson_append_header_fields(bson_t *b, const ROSMessages::std_msgs::Header *h)
+	{
+		BSON_APPEND_INT32(b, "seq", h->seq);
+
+		bson_t stamp;
+		BSON_APPEND_DOCUMENT_BEGIN(b, "stamp", &stamp);
+		BSON_APPEND_INT32(&stamp, "secs", h->time._Sec);
+		BSON_APPEND_INT32(&stamp, "nsecs", h->time._NSec);
+		bson_append_document_end(b, &stamp);
+
+		const TArray<ANSICHAR>& FrameId = _utf8_frame_id(h->frame_id);
+		// libbson appends null instead of an empty string without data
+		bson_append_utf8(b, "frame_id", -1, FrameId.Num() > 0 ? FrameId.GetData() : "", FrameId.Num());
+	}
+
+	// UTF-8 bytes of FrameId, without the terminating zero.
+	// The frame_ids that have been published last on the calling thread are cached, so they are only converted once.
+	// A topic is published from one thread and keeps its frame_id, converters just don't know their topic.
+	// The result is valid until the next call on the same thread.
+	static const TArray<ANSICHAR>& _utf8_frame_id(const FString& FrameId);
+
+	// Number of frame_ids that _utf8_frame_id converted on the calling thread, i.e. its cache misses
+	static uint64 _num_frame_id_conversions();
+
+	// Writes the values of a header appended by _bson_append_header
+	static void _bson_write_header(FBSONTemplateWriter& w, const ROSMessages::std_msgs::Header *h)
+	{
+		w.Int32(h->seq);
+		w.Int32(h->time._Sec);
+		w.Int32(h->time._NSec);
+		w.String(h->frame_id);
+	}
+};
@@ -10,16 +10,14 @@ bool UStdMsgsMultiArrayDimensionConverter::ConvertIncomingMessage(const ROSBridg
 {
 	auto p = new ROSMessages::std_msgs::MultiArrayDimension;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_multi_array_dimension(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_multi_array_dimension_decoder(), *p);
 }
 
-bool UStdMsgsMultiArrayDimensionConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UStdMsgsMultiArrayDimensionConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto mad = StaticCastSharedPtr<ROSMessages::std_msgs::MultiArrayDimension>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_multi_array_dimension(*message, mad.Get());
+	_bson_append_multi_array_dimension(message, mad.Get());
 
 	return true;
 }
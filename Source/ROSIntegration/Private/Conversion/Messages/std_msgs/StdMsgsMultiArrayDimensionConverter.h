@@ -16,16 +16,21 @@ class ROSINTEGRATION_API UStdMsgsMultiArrayDimensionConverter : public UBaseMess
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_multi_array_dimension(bson_t *b, FString key, ROSMessages::std_msgs::MultiArrayDimension *mad, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::std_msgs::MultiArrayDimension>& _bson_multi_array_dimension_decoder()
 	{
-		bool KeyFound = false;
+		using ROSMessages::std_msgs::MultiArrayDimension;
+		static const auto Decoder = TBSONFieldDecoder<MultiArrayDimension>()
+			.Field("label", &MultiArrayDimension::label)
+			.Field("size", &MultiArrayDimension::size)
+			.Field("stride", &MultiArrayDimension::stride);
+		return Decoder;
+	}
 
-		mad->label = GetFStringFromBSON(key + ".label", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		mad->size = GetInt32FromBSON(key + ".size", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		mad->stride = GetInt32FromBSON(key + ".stride", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
-		return true;
+	static bool _bson_extract_child_multi_array_dimension(bson_t *b, FString key, ROSMessages::std_msgs::MultiArrayDimension *mad, bool LogOnErrors = true)
+	{
+		return _bson_multi_array_dimension_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *mad, LogOnErrors);
 	}
 
 	static void _bson_append_child_multi_array_dimension(bson_t *b, const char *key, const ROSMessages::std_msgs::MultiArrayDimension *mad)
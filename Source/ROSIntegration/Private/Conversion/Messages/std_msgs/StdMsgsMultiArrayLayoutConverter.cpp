@@ -11,16 +11,14 @@ bool UStdMsgsMultiArrayLayoutConverter::ConvertIncomingMessage(const ROSBridgePu
 {
 	auto p = new ROSMessages::std_msgs::MultiArrayLayout;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_multi_array_layout(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_multi_array_layout_decoder(), *p);
 }
 
-bool UStdMsgsMultiArrayLayoutConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UStdMsgsMultiArrayLayoutConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto Pose = StaticCastSharedPtr<ROSMessages::std_msgs::MultiArrayLayout>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_multi_array_layout(*message, Pose.Get());
+	_bson_append_multi_array_layout(message, Pose.Get());
 
 	return true;
 }
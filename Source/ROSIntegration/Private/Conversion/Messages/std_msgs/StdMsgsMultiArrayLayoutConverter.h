@@ -17,23 +17,20 @@ class ROSINTEGRATION_API UStdMsgsMultiArrayLayoutConverter : public UBaseMessage
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_multi_array_layout(bson_t *b, FString key, ROSMessages::std_msgs::MultiArrayLayout *mal, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::std_msgs::MultiArrayLayout>& _bson_multi_array_layout_decoder()
 	{
-		bool KeyFound = false;
-
-		mal->dim = GetTArrayFromBSON<ROSMessages::std_msgs::MultiArrayDimension>(key + ".dim", b, KeyFound, [LogOnErrors](FString subKey, bson_t* subMsg, bool& subKeyFound)
-		{
-			ROSMessages::std_msgs::MultiArrayDimension ret;
-			subKeyFound = UStdMsgsMultiArrayDimensionConverter::_bson_extract_child_multi_array_dimension(subMsg, subKey, &ret, LogOnErrors);
-			return ret;
-		}, LogOnErrors);
-		if (!KeyFound) return false;
-
-		mal->data_offset = GetInt32FromBSON(key + ".data_offset", b, KeyFound, LogOnErrors); if (!KeyFound) return false;
+		using ROSMessages::std_msgs::MultiArrayLayout;
+		static const auto Decoder = TBSONFieldDecoder<MultiArrayLayout>()
+			.Field("dim", &MultiArrayLayout::dim, UStdMsgsMultiArrayDimensionConverter::_bson_multi_array_dimension_decoder())
+			.Field("data_offset", &MultiArrayLayout::data_offset);
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_multi_array_layout(bson_t *b, FString key, ROSMessages::std_msgs::MultiArrayLayout *mal, bool LogOnErrors = true)
+	{
+		return _bson_multi_array_layout_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *mal, LogOnErrors);
 	}
 
 	static void _bson_append_child_multi_array_layout(bson_t *b, const char *key, const ROSMessages::std_msgs::MultiArrayLayout *mal)
@@ -1,28 +1,49 @@
 #include "Conversion/Messages/std_msgs/StdMsgsStringConverter.h"
 
+#include "ROSMessageCodec.h"
+
 
 UStdMsgsStringConverter::UStdMsgsStringConverter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
-	_MessageType = "std_msgs/String";
+	_MessageType = TROSMessageCodec<ROSMessages::std_msgs::String>::MessageType();
 }
 
-bool UStdMsgsStringConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+static const TBSONFieldDecoder<ROSMessages::std_msgs::String>& _bson_string_decoder()
 {
-	bool KeyFound = false;
+	using ROSMessages::std_msgs::String;
+	static const auto Decoder = TBSONFieldDecoder<String>()
+		.Field("data", &String::_Data);
+	return Decoder;
+}
 
-	FString Data = GetFStringFromBSON(TEXT("msg.data"), message->full_msg_bson_, KeyFound);
-	if (!KeyFound) return false;
+bool TROSMessageCodec<ROSMessages::std_msgs::String>::Decode(const ROSBridgePublishMsg& message, ROSMessages::std_msgs::String& Msg)
+{
+	return UBaseMessageConverter::DecodeMessage(&message, _bson_string_decoder(), Msg);
+}
 
-	BaseMsg = TSharedPtr<FROSBaseMsg>(new ROSMessages::std_msgs::String(Data));
+bool TROSMessageCodec<ROSMessages::std_msgs::String>::Append(const ROSMessages::std_msgs::String& Msg, bson_t* message)
+{
+	BCON_APPEND(message,
+		"data", TCHAR_TO_UTF8(*Msg._Data)
+	);
 	return true;
 }
 
-bool UStdMsgsStringConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool TROSMessageCodec<ROSMessages::std_msgs::String>::WriteTemplateValues(const ROSMessages::std_msgs::String& Msg, FBSONTemplateWriter& Writer)
+{
+	return false;
+}
+
+bool UStdMsgsStringConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+{
+	auto p = new ROSMessages::std_msgs::String;
+	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
+	return TROSMessageCodec<ROSMessages::std_msgs::String>::Decode(*message, *p);
+}
+
+bool UStdMsgsStringConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto StringMessage = StaticCastSharedPtr<ROSMessages::std_msgs::String>(BaseMsg);
-	*message = BCON_NEW(
-		"data", TCHAR_TO_UTF8(*StringMessage->_Data)
-	);
-	return true;
+	return TROSMessageCodec<ROSMessages::std_msgs::String>::Append(*StringMessage, message);
 }
@@ -10,16 +10,14 @@ bool UStdMsgsUInt8MultiArrayConverter::ConvertIncomingMessage(const ROSBridgePub
 {
 	auto p = new ROSMessages::std_msgs::UInt8MultiArray;
 	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-	return _bson_extract_child_uint8_multi_array(message->full_msg_bson_, "msg", p);
+	return DecodeMessage(message, _bson_uint8_multi_array_decoder(), *p);
 }
 
-bool UStdMsgsUInt8MultiArrayConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+bool UStdMsgsUInt8MultiArrayConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 {
 	auto bma = StaticCastSharedPtr<ROSMessages::std_msgs::UInt8MultiArray>(BaseMsg);
 
-	*message = new bson_t;
-	bson_init(*message);
-	_bson_append_uint8_multi_array(*message, bma.Get());
+	_bson_append_uint8_multi_array(message, bma.Get());
 
 	return true;
 }
@@ -17,16 +17,26 @@ class ROSINTEGRATION_API UStdMsgsUInt8MultiArrayConverter : public UBaseMessageC
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
-	static bool _bson_extract_child_uint8_multi_array(bson_t *b, FString key, ROSMessages::std_msgs::UInt8MultiArray *bma, bool LogOnErrors = true)
+	static const TBSONFieldDecoder<ROSMessages::std_msgs::UInt8MultiArray>& _bson_uint8_multi_array_decoder()
 	{
-		bool KeyFound = false;
-
-		KeyFound = UStdMsgsMultiArrayLayoutConverter::_bson_extract_child_multi_array_layout(b, key + ".layout", &bma->layout, LogOnErrors); if (!KeyFound) return false;
-		bma->data = rosbridge2cpp::Helper::get_binary_by_key(TCHAR_TO_UTF8(*(key + ".data")), *b, bma->layout.dim[0].size, KeyFound);
+		using ROSMessages::std_msgs::UInt8MultiArray;
+		static const auto Decoder = TBSONFieldDecoder<UInt8MultiArray>()
+			.Field("layout", &UInt8MultiArray::layout, UStdMsgsMultiArrayLayoutConverter::_bson_multi_array_layout_decoder())
+			.Field("data", [](const bson_iter_t& Iter, UInt8MultiArray& bma) {
+				// the size of the data is stored in the first dimension
+				uint32_t Length = 0;
+				if (!FBSONValueReader::ReadBinary(Iter, bma.data, Length)) return false;
+				if (bma.layout.dim.Num() > 0) bma.layout.dim[0].size = Length;
+				return true;
+			}, false);
+		return Decoder;
+	}
 
-		return true;
+	static bool _bson_extract_child_uint8_multi_array(bson_t *b, FString key, ROSMessages::std_msgs::UInt8MultiArray *bma, bool LogOnErrors = true)
+	{
+		return _bson_uint8_multi_array_decoder().DecodeChild(b, TCHAR_TO_UTF8(*key), *bma, LogOnErrors);
 	}
 
 	static void _bson_append_child_uint8_multi_array(bson_t *b, const char *key, const ROSMessages::std_msgs::UInt8MultiArray *fma)
@@ -1,61 +1,56 @@
 #include "Conversion/Messages/tf2_msgs/Tf2MsgsTFMessageConverter.h"
 
 #include "tf2_msgs/TFMessage.h"
+#include "ROSMessageCodec.h"
 
 
 UTf2MsgsTFMessageConverter::UTf2MsgsTFMessageConverter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
-	_MessageType = "tf2_msgs/TFMessage";
+	_MessageType = TROSMessageCodec<ROSMessages::tf2_msgs::TFMessage>::MessageType();
 }
 
-bool UTf2MsgsTFMessageConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg) {
-//    UE_LOG(LogTemp, Display , TEXT("ROSIntegration: TFMessage received"));
-    auto p = new ROSMessages::tf2_msgs::TFMessage;
-    BaseMsg = TSharedPtr<FROSBaseMsg>(p);
-    bool keyFound = false;
-    p->transforms = GetTFMessageTArrayFromBSON("msg.transforms", message->full_msg_bson_, keyFound, false);
-	return keyFound;
+static const TBSONFieldDecoder<ROSMessages::tf2_msgs::TFMessage>& _bson_tf_message_decoder()
+{
+	using ROSMessages::tf2_msgs::TFMessage;
+	static const auto Decoder = TBSONFieldDecoder<TFMessage>()
+		.Field("transforms", &TFMessage::transforms, UGeometryMsgsTransformStampedConverter::_bson_transform_stamped_decoder());
+	return Decoder;
 }
 
-bool UTf2MsgsTFMessageConverter::ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message) {
-	auto TFMessage = StaticCastSharedPtr<ROSMessages::tf2_msgs::TFMessage>(BaseMsg);
-	if (TFMessage->transforms.Num() == 0) {
+bool TROSMessageCodec<ROSMessages::tf2_msgs::TFMessage>::Decode(const ROSBridgePublishMsg& message, ROSMessages::tf2_msgs::TFMessage& Msg)
+{
+	return UBaseMessageConverter::DecodeMessage(&message, _bson_tf_message_decoder(), Msg);
+}
+
+bool TROSMessageCodec<ROSMessages::tf2_msgs::TFMessage>::Append(const ROSMessages::tf2_msgs::TFMessage& TFMessage, bson_t* message)
+{
+	if (TFMessage.transforms.Num() == 0) {
 		UE_LOG(LogTemp, Warning, TEXT("No transform saved in TFMessage. Can't convert message"));
 		return false;
 	}
 
-	auto FirstTFMessage = TFMessage->transforms[0];
-
-	*message = BCON_NEW(
-		"transforms",
-		"[",
-		"{",
-		"header", "{",
-		"seq", BCON_INT32(FirstTFMessage.header.seq),
-		"stamp", "{",
-		"secs", BCON_INT32(FirstTFMessage.header.time._Sec),
-		"nsecs", BCON_INT32(FirstTFMessage.header.time._NSec),
-		"}",
-		"frame_id", BCON_UTF8(TCHAR_TO_ANSI(*FirstTFMessage.header.frame_id)),
-		"}",
-		"child_frame_id", BCON_UTF8(TCHAR_TO_ANSI(*FirstTFMessage.child_frame_id)),
-		"transform", "{",
-		"translation", "{",
-		"x", BCON_DOUBLE(FirstTFMessage.transform.translation.x),
-		"y", BCON_DOUBLE(FirstTFMessage.transform.translation.y),
-		"z", BCON_DOUBLE(FirstTFMessage.transform.translation.z),
-		"}",
-		"rotation", "{",
-		"x", BCON_DOUBLE(FirstTFMessage.transform.rotation.x),
-		"y", BCON_DOUBLE(FirstTFMessage.transform.rotation.y),
-		"z", BCON_DOUBLE(FirstTFMessage.transform.rotation.z),
-		"w", BCON_DOUBLE(FirstTFMessage.transform.rotation.w),
-		"}",
-		"}",
-		"}",
-		"]"
-	);
+	UBaseMessageConverter::_bson_append_tarray<ROSMessages::geometry_msgs::TransformStamped>(message, "transforms", TFMessage.transforms, [](bson_t* msg, const char* key, const ROSMessages::geometry_msgs::TransformStamped& transform_stamped)
+	{
+		UGeometryMsgsTransformStampedConverter::_bson_append_child_transform_stamped(msg, key, &transform_stamped);
+	});
 
 	return true;
 }
+
+bool TROSMessageCodec<ROSMessages::tf2_msgs::TFMessage>::WriteTemplateValues(const ROSMessages::tf2_msgs::TFMessage& TFMessage, FBSONTemplateWriter& Writer)
+{
+	return false;
+}
+
+bool UTf2MsgsTFMessageConverter::ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+{
+	auto p = new ROSMessages::tf2_msgs::TFMessage;
+	BaseMsg = TSharedPtr<FROSBaseMsg>(p);
+	return TROSMessageCodec<ROSMessages::tf2_msgs::TFMessage>::Decode(*message, *p);
+}
+
+bool UTf2MsgsTFMessageConverter::AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message) {
+	auto TFMessage = StaticCastSharedPtr<ROSMessages::tf2_msgs::TFMessage>(BaseMsg);
+	return TROSMessageCodec<ROSMessages::tf2_msgs::TFMessage>::Append(*TFMessage, message);
+}
@@ -16,7 +16,7 @@ class ROSINTEGRATION_API UTf2MsgsTFMessageConverter: public UBaseMessageConverte
 
 public:
 	virtual bool ConvertIncomingMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg);
-	virtual bool ConvertOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message);
+	virtual bool AppendOutgoingMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message);
 
     static ROSMessages::geometry_msgs::TransformStamped GetTransformStampedFromBSON(FString key, bson_t* msg, bool &keyFound, bool LogOnErrors = true)
     {
@@ -30,9 +30,11 @@ public:
 
     static TArray<ROSMessages::geometry_msgs::TransformStamped> GetTFMessageTArrayFromBSON(FString Key, bson_t* msg, bool &KeyFound, bool LogOnErrors = true)
     {
-        return GetTArrayFromBSON<ROSMessages::geometry_msgs::TransformStamped>(
-                Key, msg, KeyFound, 
-                [LogOnErrors](FString subKey, bson_t* subMsg, bool& subKeyFound) { return GetTransformStampedFromBSON(subKey, subMsg, subKeyFound, LogOnErrors); },
+        return GetTArrayFromBSONElements<ROSMessages::geometry_msgs::TransformStamped>(
+                Key, msg, KeyFound,
+                [LogOnErrors](const bson_iter_t& iter, ROSMessages::geometry_msgs::TransformStamped& transform) {
+                    return UGeometryMsgsTransformStampedConverter::_bson_transform_stamped_decoder().DecodeValue(iter, transform, LogOnErrors);
+                },
             LogOnErrors);
     }
 };
@@ -1,16 +1,33 @@
 #include "ROSIntegration.h"
+#include "Conversion/ConverterRegistry.h"
+#include <UObject/UObjectGlobals.h>
 
 #define LOCTEXT_NAMESPACE "FROSIntegrationModule"
 
 void FROSIntegrationModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// The classes of this module have been registered at this point, so the first topic doesn't have to look for its converter
+	if (UObjectInitialized())
+	{
+		FConverterRegistry::Get().Build();
+	}
+
+	// Modules loaded later may add converters
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([](FName ModuleName, EModuleChangeReason Reason) {
+		if (Reason == EModuleChangeReason::ModuleLoaded)
+		{
+			FConverterRegistry::Get().Invalidate();
+		}
+	});
 }
 
 void FROSIntegrationModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
 }
 
 #undef LOCTEXT_NAMESPACE
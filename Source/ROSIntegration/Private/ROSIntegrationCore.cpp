@@ -3,6 +3,7 @@
 #include "rosbridge2cpp/TCPConnection.h"
 #include "rosbridge2cpp/ros_bridge.h"
 #include "rosbridge2cpp/ros_topic.h"
+#include "SharedSubscriptions.h"
 
 #include "SpawnManager.h"
 #include "SpawnObjectMessage.h"
@@ -256,6 +257,8 @@ public:
 	~Impl()
 	{
 		UE_LOG(LogROS, Display, TEXT("UROSIntegrationCore ~Impl() "));
+		// topics that are still subscribed must not unsubscribe from the destroyed bridge
+		FSharedSubscriptions::Get().RemoveBridge(_Ros);
 		//_World = nullptr;
 		_SpawnManager = nullptr;
 	}
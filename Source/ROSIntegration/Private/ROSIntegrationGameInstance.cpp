@@ -1,6 +1,8 @@
 #include "ROSIntegrationGameInstance.h"
 #include "RI/Topic.h"
 #include "RI/Service.h"
+#include "TFAggregator.h"
+#include "TFBuffer.h"
 #include "ROSTime.h"
 #include "rosgraph_msgs/Clock.h"
 #include "Misc/App.h"
@@ -87,7 +89,7 @@ void UROSIntegrationGameInstance::Init()
 
 			ClockTopic = NewObject<UTopic>(UTopic::StaticClass()); // ORIGINAL
 
-			ClockTopic->Init(ROSIntegrationCore, FString(TEXT("/clock")), FString(TEXT("rosgraph_msgs/Clock")), 3);
+			ClockTopic->Init(ROSIntegrationCore, FString(TEXT("/clock")), FString(TEXT("rosgraph_msgs/Clock")), 3, ETopicPriority::Control);
 
 			ClockTopic->Advertise();
 		}
@@ -148,9 +150,43 @@ void UROSIntegrationGameInstance::CheckROSBridgeHealth()
 		}
 	}
 
+	// the latched message on /tf_static is gone with the old connection
+	if (TFAggregator)
+	{
+		TFAggregator->RepublishStaticTransforms();
+	}
+
 	UE_LOG(LogROS, Display, TEXT("Successfully reconnected to rosbridge %s:%u."), *ROSBridgeServerHost, ROSBridgeServerPort);
 }
 
+UTFAggregator* UROSIntegrationGameInstance::GetTFAggregator()
+{
+	if (!TFAggregator)
+	{
+		TFAggregator = NewObject<UTFAggregator>(this);
+	}
+	// without a core, e.g. with bConnectToROS disabled, it only collects its components until there is one
+	if (ROSIntegrationCore && !TFAggregator->IsInitialized())
+	{
+		TFAggregator->Init(ROSIntegrationCore, GetWorld());
+	}
+	return TFAggregator;
+}
+
+UTFBuffer* UROSIntegrationGameInstance::GetTFBuffer()
+{
+	if (!TFBuffer)
+	{
+		TFBuffer = NewObject<UTFBuffer>(this);
+	}
+	// without a core it only holds the transforms that are added locally until there is one
+	if (ROSIntegrationCore && !TFBuffer->IsInitialized())
+	{
+		TFBuffer->Init(ROSIntegrationCore);
+	}
+	return TFBuffer;
+}
+
 // N.B.: from log, first comes Shutdown() and then BeginDestroy()
 void UROSIntegrationGameInstance::Shutdown()
 {
@@ -2,12 +2,10 @@
 
 #include "rosbridge2cpp/ros_bridge.h"
 #include "rosbridge2cpp/ros_service.h"
+#include "Conversion/ConverterRegistry.h"
 #include "Conversion/Services/BaseRequestConverter.h"
 #include "Conversion/Services/BaseResponseConverter.h"
 
-static TMap<FString, UBaseRequestConverter*> RequestConverterMap;
-static TMap<FString, UBaseResponseConverter*> ResponseConverterMap;
-
 
 // PIMPL
 class UService::Impl {
@@ -47,43 +45,19 @@ public:
 
 		_ROSService = new rosbridge2cpp::ROSService(Ric->_Implementation->Get()->_Ros, TCHAR_TO_UTF8(*ServiceName), TCHAR_TO_UTF8(*ServiceType));
 
-		// Construct static ConverterMaps
-		if (RequestConverterMap.Num() == 0)
-		{
-			for (TObjectIterator<UClass> It; It; ++It)
-			{
-				UClass* ClassItr = *It;
-
-				if (It->IsChildOf(UBaseRequestConverter::StaticClass()) && *It != UBaseRequestConverter::StaticClass())
-				{
-					UBaseRequestConverter* ConcreteConverter = ClassItr->GetDefaultObject<UBaseRequestConverter>();
-					UE_LOG(LogROS, Verbose, TEXT("Added %s with type %s to RequestConverterMap"), *(It->GetDefaultObjectName().ToString()), *(ConcreteConverter->_ServiceType));
-					RequestConverterMap.Add(*(ConcreteConverter->_ServiceType), ConcreteConverter);
-					continue;
-				}
-				else if (It->IsChildOf(UBaseResponseConverter::StaticClass()) && *It != UBaseResponseConverter::StaticClass())
-				{
-					UBaseResponseConverter* ConcreteConverter = ClassItr->GetDefaultObject<UBaseResponseConverter>();
-					UE_LOG(LogROS, Verbose, TEXT("Added %s with type %s to ResponseConverterMap"), *(It->GetDefaultObjectName().ToString()), *(ConcreteConverter->_ServiceType));
-					ResponseConverterMap.Add(*(ConcreteConverter->_ServiceType), ConcreteConverter);
-					continue;
-				}
-			}
-		}
+		const FName ServiceTypeName(*ServiceType);
 
-		UBaseResponseConverter** ResponseConverter = ResponseConverterMap.Find(_ServiceType);
-		if (!ResponseConverter) {
+		_ResponseConverter = FConverterRegistry::Get().FindResponseConverter(ServiceTypeName);
+		if (!_ResponseConverter) {
 			UE_LOG(LogROS, Error, TEXT("ServiceType is unknown. Can't find Converter to encode service call"));
 			return;
 		}
-		_ResponseConverter = *ResponseConverter;
 
-		UBaseRequestConverter** RequestConverter = RequestConverterMap.Find(_ServiceType);
-		if (!RequestConverter) {
+		_RequestConverter = FConverterRegistry::Get().FindRequestConverter(ServiceTypeName);
+		if (!_RequestConverter) {
 			UE_LOG(LogROS, Error, TEXT("ServiceType is unknown. Can't find Converter to decode service call"));
 			return;
 		}
-		_RequestConverter = *RequestConverter;
 	}
 
 	void CallServiceCallback(const ROSBridgeServiceResponseMsg &message, std::function<void(TSharedPtr<FROSBaseServiceResponse>)> ServiceResponse) {
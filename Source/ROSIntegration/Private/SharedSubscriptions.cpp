@@ -0,0 +1,213 @@
+#include "SharedSubscriptions.h"
+
+#include "Conversion/Messages/BaseMessageConverter.h"
+
+FSharedSubscriptions& FSharedSubscriptions::Get()
+{
+	static FSharedSubscriptions SharedSubscriptions;
+	return SharedSubscriptions;
+}
+
+FSharedSubscriptions::FHandle FSharedSubscriptions::Subscribe(rosbridge2cpp::ROSBridge& Ros, const FString& Topic, const FString& MessageType,
+	UBaseMessageConverter* Converter, int32 QueueSize, rosbridge2cpp::ReceiveQueuePolicy QueuePolicy, std::shared_ptr<FListener> Listener)
+{
+	for (;;) {
+		std::shared_ptr<FSubscription> Subscription;
+		std::shared_future<void> Pending;
+		std::promise<void> Sent;
+		{
+			FScopeLock Lock(&Mutex);
+
+			// subscribing is rare and there are only a few topics, so the subscriptions are searched linearly
+			for (const std::shared_ptr<FSubscription>& Existing : Subscriptions) {
+				if (Existing->Matches(Ros, Topic, MessageType, QueueSize, QueuePolicy)) {
+					Subscription = Existing;
+					break;
+				}
+			}
+
+			if (Subscription && Subscription->bSubscribed) {
+				return AddListener(Subscription, Listener);
+			}
+
+			if (Subscription) {
+				Pending = Subscription->SubscribeSent;
+			}
+			else {
+				Subscription = std::make_shared<FSubscription>(Ros, Topic, MessageType, Converter, QueueSize, QueuePolicy);
+				Subscription->SubscribeSent = Sent.get_future().share();
+				Subscriptions.Add(Subscription);
+			}
+		}
+
+		if (Pending.valid()) {
+			// another UTopic is sending the subscribe, look again once it is done
+			Pending.wait();
+			continue;
+		}
+
+		// sent without the lock, subscribers of other topics don't wait for the connection
+		std::weak_ptr<FSubscription> WeakSubscription = Subscription;
+		rosbridge2cpp::ROSCallbackHandle<rosbridge2cpp::FunVrROSPublishMsg> CallbackHandle = Subscription->ROSTopic->Subscribe(
+			[WeakSubscription](const ROSBridgePublishMsg &message) {
+				if (std::shared_ptr<FSubscription> Current = WeakSubscription.lock()) {
+					Current->Dispatch(message);
+				}
+			});
+
+		FHandle Handle;
+		{
+			FScopeLock Lock(&Mutex);
+			if (CallbackHandle.IsValid()) {
+				Subscription->CallbackHandle = CallbackHandle;
+				Subscription->bSubscribed = true;
+				Handle = AddListener(Subscription, Listener);
+			}
+			else {
+				Subscriptions.Remove(Subscription);
+			}
+		}
+		Sent.set_value();
+		return Handle;
+	}
+}
+
+FSharedSubscriptions::FHandle FSharedSubscriptions::AddListener(const std::shared_ptr<FSubscription>& Subscription, std::shared_ptr<FListener> Listener)
+{
+	{
+		FScopeLock ListenersLock(&Subscription->ListenersMutex);
+		auto Listeners = std::make_shared<TArray<std::shared_ptr<FListener>>>(*Subscription->Listeners);
+		Listeners->Add(Listener);
+		Subscription->Listeners = Listeners;
+	}
+
+	FHandle Handle;
+	Handle.Subscription = Subscription;
+	Handle.Listener = Listener;
+	return Handle;
+}
+
+bool FSharedSubscriptions::Unsubscribe(FHandle& Handle, bool bConnected)
+{
+	if (!Handle.IsValid()) {
+		return true;
+	}
+
+	// messages that are already being dispatched are skipped
+	Handle.Listener->bActive = false;
+
+	std::shared_ptr<FSubscription> Subscription = Handle.Subscription;
+	{
+		FScopeLock Lock(&Mutex);
+		bool bEmpty;
+		{
+			FScopeLock ListenersLock(&Subscription->ListenersMutex);
+			auto Listeners = std::make_shared<TArray<std::shared_ptr<FListener>>>(*Subscription->Listeners);
+			Listeners->Remove(Handle.Listener);
+			Subscription->Listeners = Listeners;
+			bEmpty = Listeners->Num() == 0;
+		}
+		Handle = FHandle();
+
+		if (!bEmpty || Subscription->bDetached) {
+			return true;
+		}
+		Subscriptions.Remove(Subscription);
+	}
+
+	// Nobody else can reach the subscription anymore. The unsubscribe is sent without the lock, and stopping the
+	// receive queue joins its thread, which may be delivering a message to a callback that subscribes another UTopic.
+	bool result = true;
+	if (bConnected) {
+		result = Subscription->ROSTopic->Unsubscribe(Subscription->CallbackHandle);
+	}
+	// a callback that is still registered in a broken connection only holds a weak reference
+	Subscription->ROSTopic.reset();
+	return result;
+}
+
+void FSharedSubscriptions::RemoveBridge(rosbridge2cpp::ROSBridge& Ros)
+{
+	TArray<std::shared_ptr<FSubscription>> Removed;
+	TArray<std::shared_future<void>> Pending;
+	{
+		FScopeLock Lock(&Mutex);
+		for (int32 i = Subscriptions.Num() - 1; i >= 0; --i) {
+			if (Subscriptions[i]->Ros == &Ros) {
+				// the UTopics still hold their handles, but must not use the ROSTopic of the destroyed bridge
+				Subscriptions[i]->bDetached = true;
+				Removed.Add(Subscriptions[i]);
+				Pending.Add(Subscriptions[i]->SubscribeSent);
+				Subscriptions.RemoveAt(i);
+			}
+		}
+	}
+
+	for (int32 i = 0; i < Removed.Num(); ++i) {
+		// waits for a subscribe that is still being sent
+		Pending[i].wait();
+		Removed[i]->ROSTopic.reset();
+	}
+}
+
+int32 FSharedSubscriptions::NumListeners() const
+{
+	FScopeLock Lock(&Mutex);
+	int32 Num = 0;
+	for (const std::shared_ptr<FSubscription>& Subscription : Subscriptions) {
+		FScopeLock ListenersLock(&Subscription->ListenersMutex);
+		Num += Subscription->Listeners->Num();
+	}
+	return Num;
+}
+
+FSharedSubscriptions::FSubscription::FSubscription(rosbridge2cpp::ROSBridge& Ros, const FString& Topic, const FString& MessageType,
+	UBaseMessageConverter* Converter, int32 QueueSize, rosbridge2cpp::ReceiveQueuePolicy QueuePolicy)
+: Ros(&Ros)
+, Topic(Topic)
+, MessageType(MessageType)
+, Converter(Converter)
+, QueueSize(QueueSize)
+, QueuePolicy(QueuePolicy)
+, ROSTopic(new rosbridge2cpp::ROSTopic(Ros, TCHAR_TO_UTF8(*Topic), TCHAR_TO_UTF8(*MessageType), QueueSize))
+, Listeners(std::make_shared<TArray<std::shared_ptr<FListener>>>())
+{
+	// all listeners share the receive queue
+	ROSTopic->SetReceiveQueuePolicy(QueuePolicy);
+}
+
+bool FSharedSubscriptions::FSubscription::Matches(const rosbridge2cpp::ROSBridge& InRos, const FString& InTopic, const FString& InMessageType,
+	int32 InQueueSize, rosbridge2cpp::ReceiveQueuePolicy InQueuePolicy) const
+{
+	// topic and message type names are case-sensitive, unlike FString ==
+	return Ros == &InRos && Topic.Equals(InTopic, ESearchCase::CaseSensitive) && MessageType.Equals(InMessageType, ESearchCase::CaseSensitive)
+		&& QueueSize == InQueueSize && QueuePolicy == InQueuePolicy;
+}
+
+void FSharedSubscriptions::FSubscription::Dispatch(const ROSBridgePublishMsg& message) const
+{
+	std::shared_ptr<const TArray<std::shared_ptr<FListener>>> Current;
+	{
+		FScopeLock Lock(&ListenersMutex);
+		Current = Listeners;
+	}
+
+	for (const std::shared_ptr<FListener>& Listener : *Current) {
+		if (!Listener->bActive) continue;
+
+		if (Listener->EncodedCallback) {
+			Listener->EncodedCallback(message);
+			continue;
+		}
+
+		// every callback gets its own message, so one of them modifying it doesn't affect the others
+		TSharedPtr<FROSBaseMsg> BaseMsg;
+		if (!Converter->ConvertIncomingMessage(&message, BaseMsg)) {
+			UE_LOG(LogROS, Error, TEXT("Couldn't convert incoming Message; Skipping callback"));
+			continue;
+		}
+		if (BaseMsg.IsValid()) {
+			Listener->Callback(BaseMsg);
+		}
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include "ROSBaseMsg.h"
+#include "rosbridge2cpp/ros_bridge.h"
+#include "rosbridge2cpp/ros_topic.h"
+
+class UBaseMessageConverter;
+
+/**
+ * rosbridge subscriptions that are shared by all UTopics with the same bridge, topic, message type and receive queue.
+ * Each of them subscribes once and receives every message once. Every listener gets its own converted FROSBaseMsg,
+ * which it may modify. Listeners of typed topics get the incoming message and decode it themselves.
+ * A slow listener delays the other listeners of its subscription, like callbacks on the same ROSTopic.
+ * The rosbridge subscription ends with its last listener.
+ * Subscribe and unsubscribe requests are sent without holding the lock of the subscriptions.
+ */
+class FSharedSubscriptions
+{
+public:
+	// A UTopic that listens to a shared subscription.
+	// Incoming messages are dispatched without waiting for Unsubscribe(), so callbacks that are still running
+	// afterwards keep it alive.
+	struct FListener
+	{
+		std::function<void(TSharedPtr<FROSBaseMsg>)> Callback;
+		std::function<void(const ROSBridgePublishMsg&)> EncodedCallback; // gets the message without converting it
+		std::atomic<bool> bActive{ true };
+	};
+
+	class FSubscription;
+
+	struct FHandle
+	{
+		std::shared_ptr<FSubscription> Subscription;
+		std::shared_ptr<FListener> Listener;
+
+		bool IsValid() const { return Subscription && Listener; }
+	};
+
+	static FSharedSubscriptions& Get();
+
+	// Adds Listener to the subscription of the topic, which is subscribed if it is the first listener.
+	// Returns an invalid handle if subscribing fails.
+	FHandle Subscribe(rosbridge2cpp::ROSBridge& Ros, const FString& Topic, const FString& MessageType, UBaseMessageConverter* Converter,
+		int32 QueueSize, rosbridge2cpp::ReceiveQueuePolicy QueuePolicy, std::shared_ptr<FListener> Listener);
+
+	// Removes the listener of Handle and resets it. The last listener unsubscribes from the topic, unless the connection is broken.
+	// Returns false if sending the unsubscribe fails.
+	bool Unsubscribe(FHandle& Handle, bool bConnected = true);
+
+	// Forgets the subscriptions of a bridge that is destroyed, their listeners are released without unsubscribing
+	void RemoveBridge(rosbridge2cpp::ROSBridge& Ros);
+
+	// Number of listeners of all subscriptions
+	int32 NumListeners() const;
+
+	class FSubscription
+	{
+	public:
+		FSubscription(rosbridge2cpp::ROSBridge& Ros, const FString& Topic, const FString& MessageType, UBaseMessageConverter* Converter,
+			int32 QueueSize, rosbridge2cpp::ReceiveQueuePolicy QueuePolicy);
+
+		bool Matches(const rosbridge2cpp::ROSBridge& InRos, const FString& InTopic, const FString& InMessageType,
+			int32 InQueueSize, rosbridge2cpp::ReceiveQueuePolicy InQueuePolicy) const;
+
+		// Passes message to all listeners, converting it for each of them
+		void Dispatch(const ROSBridgePublishMsg& message) const;
+
+	private:
+		friend class FSharedSubscriptions;
+
+		rosbridge2cpp::ROSBridge* Ros;
+		FString Topic;
+		FString MessageType;
+		UBaseMessageConverter* Converter;
+		int32 QueueSize;
+		rosbridge2cpp::ReceiveQueuePolicy QueuePolicy;
+
+		std::unique_ptr<rosbridge2cpp::ROSTopic> ROSTopic;
+		rosbridge2cpp::ROSCallbackHandle<rosbridge2cpp::FunVrROSPublishMsg> CallbackHandle;
+		// Guarded by FSharedSubscriptions::Mutex. Other subscribers of the topic wait for SubscribeSent,
+		// bSubscribed tells them whether it succeeded.
+		std::shared_future<void> SubscribeSent;
+		bool bSubscribed = false;
+		bool bDetached = false; // the bridge is gone
+
+		// replaced as a whole, so Dispatch iterates over a stable list without holding the lock
+		mutable FCriticalSection ListenersMutex;
+		std::shared_ptr<const TArray<std::shared_ptr<FListener>>> Listeners;
+	};
+
+private:
+	// Adds Listener to Subscription, Mutex has to be locked
+	static FHandle AddListener(const std::shared_ptr<FSubscription>& Subscription, std::shared_ptr<FListener> Listener);
+
+	mutable FCriticalSection Mutex;
+	TArray<std::shared_ptr<FSubscription>> Subscriptions;
+};
@@ -0,0 +1,133 @@
+#include "TFAggregator.h"
+
+#include "TFBroadcastComponent.h"
+#include "tf2_msgs/TFMessage.h"
+#include "ROSTime.h"
+
+void UTFAggregator::Init(UROSIntegrationCore* ROSIntegrationCore, UWorld* World)
+{
+	_World = World;
+
+	if (!_TFTopic) {
+		_TFTopic = NewObject<UTopic>(UTopic::StaticClass());
+	}
+	_TFTopic->Init(ROSIntegrationCore, TEXT("/tf"), TEXT("tf2_msgs/TFMessage"), 10, ETopicPriority::Control);
+
+	if (!_TFStaticTopic) {
+		_TFStaticTopic = NewObject<UTopic>(UTopic::StaticClass());
+	}
+	_TFStaticTopic->Init(ROSIntegrationCore, TEXT("/tf_static"), TEXT("tf2_msgs/TFMessage"), 1, ETopicPriority::Control, true);
+	RepublishStaticTransforms();
+}
+
+void UTFAggregator::Register(UTFBroadcastComponent* Component)
+{
+	// the game instance outlives its worlds, e.g. OpenLevel loads a new one
+	UWorld* World = Component->GetWorld();
+	if (World && World != _World.Get()) {
+		_World = World;
+		auto IsInOtherWorld = [World](const TWeakObjectPtr<UTFBroadcastComponent>& Other) { return !Other.IsValid() || Other->GetWorld() != World; };
+		Components.RemoveAll(IsInOtherWorld);
+		if (StaticComponents.RemoveAll(IsInOtherWorld) > 0) {
+			bStaticTransformsDirty = true;
+		}
+	}
+
+	if (Component->bStatic) {
+		StaticComponents.AddUnique(Component);
+		bStaticTransformsDirty = true;
+	}
+	else {
+		Components.AddUnique(Component);
+	}
+}
+
+void UTFAggregator::Unregister(UTFBroadcastComponent* Component)
+{
+	Components.Remove(Component);
+	if (StaticComponents.Remove(Component) > 0) {
+		bStaticTransformsDirty = true;
+	}
+}
+
+void UTFAggregator::Tick(float DeltaTime)
+{
+	// all transforms of a frame share their timestamp
+	const FROSTime Time = FROSTime::Now();
+
+	Components.RemoveAll([](const TWeakObjectPtr<UTFBroadcastComponent>& Component) { return !Component.IsValid(); });
+
+	TSharedPtr<ROSMessages::tf2_msgs::TFMessage> TFMessage(new ROSMessages::tf2_msgs::TFMessage());
+	TFMessage->transforms.Reserve(Components.Num());
+	SuppressedTransforms = 0;
+	for (const TWeakObjectPtr<UTFBroadcastComponent>& Component : Components) {
+		if (Component->CollectTransform(DeltaTime, Time, TFMessage->transforms)) {
+			SuppressedTransforms++;
+		}
+	}
+	TotalSuppressedTransforms += SuppressedTransforms;
+
+	PublishedTransforms = TFMessage->transforms.Num();
+	if (PublishedTransforms > 0) {
+		_TFTopic->Publish(TFMessage);
+	}
+
+	if (StaticComponents.RemoveAll([](const TWeakObjectPtr<UTFBroadcastComponent>& Component) { return !Component.IsValid(); }) > 0) {
+		bStaticTransformsDirty = true;
+	}
+
+	for (const TWeakObjectPtr<UTFBroadcastComponent>& Component : StaticComponents) {
+		if (Component->UpdateStaticTransform(DeltaTime, Time)) {
+			bStaticTransformsDirty = true;
+		}
+	}
+	if (bStaticTransformsDirty) {
+		PublishStaticTransforms();
+	}
+}
+
+void UTFAggregator::PublishStaticTransforms()
+{
+	TSharedPtr<ROSMessages::tf2_msgs::TFMessage> TFMessage(new ROSMessages::tf2_msgs::TFMessage());
+	TFMessage->transforms.Reserve(StaticComponents.Num());
+	for (const TWeakObjectPtr<UTFBroadcastComponent>& Component : StaticComponents) {
+		if (Component->HasStaticTransform()) {
+			TFMessage->transforms.Add(Component->GetStaticTransform());
+		}
+	}
+
+	// the latched message keeps the last transforms if there are none left
+	if (TFMessage->transforms.Num() == 0) {
+		bStaticTransformsDirty = false;
+	}
+	else if (_TFStaticTopic->Publish(TFMessage)) {
+		++StaticPublishes;
+		bStaticTransformsDirty = false;
+	}
+}
+
+bool UTFAggregator::IsTickable() const
+{
+	// the class default object is registered as tickable as well, but never initialized
+	return _TFTopic != nullptr && _World.IsValid() && (Components.Num() > 0 || StaticComponents.Num() > 0);
+}
+
+bool UTFAggregator::IsTickableInEditor() const
+{
+	return false;
+}
+
+bool UTFAggregator::IsTickableWhenPaused() const
+{
+	return false;
+}
+
+TStatId UTFAggregator::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTFAggregator, STATGROUP_Tickables);
+}
+
+UWorld* UTFAggregator::GetWorld() const
+{
+	return _World.Get();
+}
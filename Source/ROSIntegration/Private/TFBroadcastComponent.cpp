@@ -1,8 +1,7 @@
 #include "TFBroadcastComponent.h"
 
 #include "ROSIntegrationGameInstance.h"
-#include "tf2_msgs/TFMessage.h"
-#include "ROSTime.h"
+#include "TFAggregator.h"
 
 // Sets default values for this component's properties
 UTFBroadcastComponent::UTFBroadcastComponent()
@@ -16,10 +15,8 @@ UTFBroadcastComponent::UTFBroadcastComponent()
 , FrameTime(1.0f / FrameRate)
 , TimePassed(0)
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these
-	// features
-	// off to improve performance if you don't need them.
-	PrimaryComponentTick.bCanEverTick = true;
+	// The transform is collected by the UTFAggregator of the game, which publishes all transforms of a frame at once
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 // Called when the game starts
@@ -29,9 +26,23 @@ void UTFBroadcastComponent::BeginPlay()
 
 	assert(GetOwner());
 
-	_TFTopic = NewObject<UTopic>(UTopic::StaticClass());
 	UROSIntegrationGameInstance* ROSInstance = Cast<UROSIntegrationGameInstance>(GetOwner()->GetGameInstance());
-	_TFTopic->Init(ROSInstance->ROSIntegrationCore, TEXT("/tf"), TEXT("tf2_msgs/TFMessage"));
+	if (!ROSInstance) {
+		UE_LOG(LogROS, Error, TEXT("[TFBroadcast] The game instance is no UROSIntegrationGameInstance, no transforms will be published"));
+		return;
+	}
+	_TFAggregator = ROSInstance->GetTFAggregator();
+	_TFAggregator->Register(this);
+}
+
+void UTFBroadcastComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (_TFAggregator) {
+		_TFAggregator->Unregister(this);
+		_TFAggregator = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 AActor* UTFBroadcastComponent::GetParentActor()
@@ -44,20 +55,81 @@ AActor* UTFBroadcastComponent::GetParentActor()
 	return RootComponent->GetAttachParent()->GetOwner();
 }
 
-// Called every frame
-void UTFBroadcastComponent::TickComponent(float DeltaTime,
-	ELevelTick TickType,
-	FActorComponentTickFunction* ThisTickFunction)
+bool UTFBroadcastComponent::IsFrameDue(float DeltaTime)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
 	// Check for framerate
 	TimePassed += DeltaTime;
 	if (TimePassed < FrameTime) {
-		return;
+		return false;
 	}
 	TimePassed -= FrameTime;
+	return true;
+}
+
+bool UTFBroadcastComponent::CollectTransform(float DeltaTime,
+	const FROSTime& Time,
+	TArray<ROSMessages::geometry_msgs::TransformStamped>& Transforms)
+{
+	TimeSincePublish += DeltaTime;
+	if (!IsFrameDue(DeltaTime)) return false;
+
+	ROSMessages::geometry_msgs::TransformStamped TransformStamped;
+	if (!ComputeTransform(Time, TransformStamped)) return false;
+
+	if (IsDeadBandEnabled()) {
+		if (bHasPublishedTransform && TimeSincePublish < KeepAliveInterval &&
+			!HasMoved(PublishedTransform, TransformStamped, DeadBandTranslation, DeadBandRotation)) {
+			SuppressedPublishes++;
+			return true;
+		}
+		PublishedTransform = TransformStamped;
+		bHasPublishedTransform = true;
+	}
+	TimeSincePublish = 0.f;
+
+	Transforms.Add(TransformStamped);
+	return false;
+}
 
+bool UTFBroadcastComponent::UpdateStaticTransform(float DeltaTime, const FROSTime& Time)
+{
+	if (!IsFrameDue(DeltaTime)) return false;
+
+	ROSMessages::geometry_msgs::TransformStamped TransformStamped;
+	if (!ComputeTransform(Time, TransformStamped)) return false;
+
+	if (bHasStaticTransform && !HasMoved(StaticTransform, TransformStamped, StaticTranslationTolerance, StaticRotationTolerance)) return false;
+
+	StaticTransform = TransformStamped;
+	bHasStaticTransform = true;
+	return true;
+}
+
+bool UTFBroadcastComponent::HasMoved(const ROSMessages::geometry_msgs::TransformStamped& From,
+	const ROSMessages::geometry_msgs::TransformStamped& To,
+	float TranslationTolerance,
+	float RotationTolerance)
+{
+	if (To.header.frame_id != From.header.frame_id || To.child_frame_id != From.child_frame_id) {
+		return true;
+	}
+
+	const ROSMessages::geometry_msgs::Vector3& A = To.transform.translation;
+	const ROSMessages::geometry_msgs::Vector3& B = From.transform.translation;
+	const double DistanceSquared = (A.x - B.x) * (A.x - B.x) + (A.y - B.y) * (A.y - B.y) + (A.z - B.z) * (A.z - B.z);
+	if (DistanceSquared > (double)TranslationTolerance * TranslationTolerance) {
+		return true;
+	}
+
+	// angle between the rotations, q and -q are the same rotation
+	const ROSMessages::geometry_msgs::Quaternion& P = To.transform.rotation;
+	const ROSMessages::geometry_msgs::Quaternion& Q = From.transform.rotation;
+	const double Dot = FMath::Min(FMath::Abs(P.x * Q.x + P.y * Q.y + P.z * Q.z + P.w * Q.w), 1.0);
+	return 2.0 * FMath::Acos(Dot) > RotationTolerance;
+}
+
+bool UTFBroadcastComponent::ComputeTransform(const FROSTime& Time, ROSMessages::geometry_msgs::TransformStamped& TransformStamped)
+{
 	TickCounter++;
 
 	bool GlobalSettingTFBroadcastEnabled = false;
@@ -84,7 +156,7 @@ void UTFBroadcastComponent::TickComponent(float DeltaTime,
 	// Skip execution when TF is deactivated globally
 	//if (!GlobalSettingTFBroadcastEnabled) return;
 
-	if (!ComponentActive) return;
+	if (!ComponentActive) return false;
 
 	assert(GetOwner() != nullptr);
 
@@ -129,7 +201,7 @@ void UTFBroadcastComponent::TickComponent(float DeltaTime,
 #else
 			UE_LOG(LogROS, Error, TEXT("[TFBroadcast] CoordsRelativeTo == ECoordinateType::COORDTYPE_RELATIVE and No Parent Component - Add a parent actor or use world coordinates. Skipping TF Broadcast"));
 #endif // WITH_EDITOR
-			return;
+			return false;
 		}
 		FTransform ThisTransformInWorldCoordinates = GetOwner()->GetRootComponent()->GetComponentTransform();
 		FTransform ParentTransformInWorldCoordinates = ParentActor->GetRootComponent()->GetComponentTransform();
@@ -150,12 +222,8 @@ void UTFBroadcastComponent::TickComponent(float DeltaTime,
 	double RotationZ = -ActorRotation.Z;
 	double RotationW = ActorRotation.W;
 
-	FROSTime time = FROSTime::Now();
-
-	TSharedPtr<ROSMessages::tf2_msgs::TFMessage> TFMessage(new ROSMessages::tf2_msgs::TFMessage());
-	ROSMessages::geometry_msgs::TransformStamped TransformStamped;
 	TransformStamped.header.seq = 0;
-	TransformStamped.header.time = time;
+	TransformStamped.header.time = Time;
 	TransformStamped.header.frame_id = CurrentParentFrameName;
 	TransformStamped.child_frame_id = CurrentThisFrameName;
 	TransformStamped.transform.translation.x = TranslationX;
@@ -166,9 +234,7 @@ void UTFBroadcastComponent::TickComponent(float DeltaTime,
 	TransformStamped.transform.rotation.z = RotationZ;
 	TransformStamped.transform.rotation.w = RotationW;
 
-	TFMessage->transforms.Add(TransformStamped);
-
-	_TFTopic->Publish(TFMessage);
+	return true;
 
 	/*rosbridge2cpp::ROSTime time = rosbridge2cpp::ROSTime::now();
 
@@ -0,0 +1,446 @@
+#include "TFBuffer.h"
+
+#include "tf2_msgs/TFMessage.h"
+
+// Longer paths between two frames are treated as a loop in the frame tree
+static const int32 MaxFrameTreeDepth = 1000;
+
+// Cached chains beyond this are dropped, lookups between many different pairs of frames would grow the cache without bound
+static const int32 MaxChains = 4096;
+
+static int64 ToStamp(const FROSTime& Time)
+{
+	return (int64)Time._Sec * 1000000000ll + (int64)Time._NSec;
+}
+
+static FROSTime ToROSTime(int64 Stamp)
+{
+	return FROSTime((unsigned long)(Stamp / 1000000000ll), (unsigned long)(Stamp % 1000000000ll));
+}
+
+void UTFBuffer::Init(UROSIntegrationCore* ROSIntegrationCore, int32 InSamplesPerFrame)
+{
+	SamplesPerFrame = FMath::Max(InSamplesPerFrame, 2);
+
+	if (!_TFTopic) {
+		_TFTopic = NewObject<UTopic>(UTopic::StaticClass());
+	}
+	// the callbacks run on the rosbridge thread and may still be running while this object is destroyed
+	TWeakObjectPtr<UTFBuffer> WeakThis(this);
+	_TFTopic->Init(ROSIntegrationCore, TEXT("/tf"), TEXT("tf2_msgs/TFMessage"), 100);
+	_TFTopic->Subscribe([WeakThis](TSharedPtr<FROSBaseMsg> Msg) {
+		if (UTFBuffer* Buffer = WeakThis.Get()) {
+			Buffer->OnTFMessage(Msg, false);
+		}
+	});
+
+	if (!_TFStaticTopic) {
+		_TFStaticTopic = NewObject<UTopic>(UTopic::StaticClass());
+	}
+	_TFStaticTopic->Init(ROSIntegrationCore, TEXT("/tf_static"), TEXT("tf2_msgs/TFMessage"), 100);
+	_TFStaticTopic->Subscribe([WeakThis](TSharedPtr<FROSBaseMsg> Msg) {
+		if (UTFBuffer* Buffer = WeakThis.Get()) {
+			Buffer->OnTFMessage(Msg, true);
+		}
+	});
+}
+
+void UTFBuffer::BeginDestroy()
+{
+	// the callbacks must not reach this object once it is gone
+	if (_TFTopic) _TFTopic->Unsubscribe();
+	if (_TFStaticTopic) _TFStaticTopic->Unsubscribe();
+
+	Super::BeginDestroy();
+}
+
+void UTFBuffer::OnTFMessage(TSharedPtr<FROSBaseMsg> Msg, bool bStatic)
+{
+	auto TFMessage = StaticCastSharedPtr<ROSMessages::tf2_msgs::TFMessage>(Msg);
+	if (TFMessage) {
+		AddTransforms(TFMessage->transforms, bStatic);
+	}
+}
+
+void UTFBuffer::AddTransforms(const TArray<ROSMessages::geometry_msgs::TransformStamped>& Transforms, bool bStatic)
+{
+	for (const ROSMessages::geometry_msgs::TransformStamped& Transform : Transforms) {
+		AddTransform(Transform, bStatic);
+	}
+}
+
+bool UTFBuffer::AddTransform(const ROSMessages::geometry_msgs::TransformStamped& Transform, bool bStatic)
+{
+	const FString Child = NormalizeFrameName(Transform.child_frame_id);
+	const FString Parent = NormalizeFrameName(Transform.header.frame_id);
+	if (Child.IsEmpty() || Parent.IsEmpty() || Child.Equals(Parent, ESearchCase::CaseSensitive)) {
+		UE_LOG(LogROS, Warning, TEXT("[TFBuffer] Ignoring transform from '%s' to '%s'"), *Transform.child_frame_id, *Transform.header.frame_id);
+		return false;
+	}
+
+	const ROSMessages::geometry_msgs::Quaternion& Rotation = Transform.transform.rotation;
+	const double Norm = FMath::Sqrt(Rotation.x * Rotation.x + Rotation.y * Rotation.y + Rotation.z * Rotation.z + Rotation.w * Rotation.w);
+	if (!(Norm > 1e-9)) {
+		UE_LOG(LogROS, Warning, TEXT("[TFBuffer] Ignoring transform from '%s' to '%s' with an invalid rotation"), *Child, *Parent);
+		return false;
+	}
+
+	FSample Sample;
+	Sample.Stamp = ToStamp(Transform.header.time);
+	Sample.Pose.X = Transform.transform.translation.x;
+	Sample.Pose.Y = Transform.transform.translation.y;
+	Sample.Pose.Z = Transform.transform.translation.z;
+	Sample.Pose.QX = Rotation.x / Norm;
+	Sample.Pose.QY = Rotation.y / Norm;
+	Sample.Pose.QZ = Rotation.z / Norm;
+	Sample.Pose.QW = Rotation.w / Norm;
+
+	FScopeLock Lock(&Mutex);
+
+	const int32 ParentIndex = FindOrAddFrame(Parent);
+	const int32 ChildIndex = FindOrAddFrame(Child);
+
+	FFrame& Frame = Frames[ChildIndex];
+	if (Frame.Parent != ParentIndex || Frame.bStatic != bStatic) {
+		// the transforms to the old parent can't be mixed with the new ones
+		Frame.Parent = ParentIndex;
+		Frame.bStatic = bStatic;
+		Frame.Samples.SetNum(bStatic ? 1 : SamplesPerFrame);
+		Frame.First = 0;
+		Frame.Num = 0;
+		++Generation;
+	}
+	InsertSample(Frame, Sample);
+	return true;
+}
+
+void UTFBuffer::InsertSample(FFrame& Frame, const FSample& Sample)
+{
+	if (Frame.bStatic) {
+		Frame.Samples[0] = Sample;
+		Frame.Num = 1;
+		return;
+	}
+
+	const int32 Capacity = Frame.Samples.Num();
+
+	// the common case, a newer transform replaces the oldest one
+	if (Frame.Num == 0 || Frame.Sample(Frame.Num - 1).Stamp < Sample.Stamp) {
+		if (Frame.Num == Capacity) {
+			Frame.First = (Frame.First + 1) % Capacity;
+			Frame.Num--;
+		}
+		Frame.Sample(Frame.Num++) = Sample;
+		return;
+	}
+
+	// first sample that isn't older
+	int32 Low = 0, High = Frame.Num;
+	while (Low < High) {
+		const int32 Mid = (Low + High) / 2;
+		if (Frame.Sample(Mid).Stamp < Sample.Stamp) Low = Mid + 1;
+		else High = Mid;
+	}
+
+	if (Frame.Sample(Low).Stamp == Sample.Stamp) {
+		Frame.Sample(Low) = Sample;
+		return;
+	}
+	if (Frame.Num == Capacity) {
+		if (Low == 0) return; // older than all buffered transforms
+		Frame.First = (Frame.First + 1) % Capacity;
+		Frame.Num--;
+		Low--;
+	}
+	for (int32 i = Frame.Num; i > Low; --i) {
+		Frame.Sample(i) = Frame.Sample(i - 1);
+	}
+	Frame.Sample(Low) = Sample;
+	Frame.Num++;
+}
+
+bool UTFBuffer::LookupTransform(const FString& TargetFrame, const FString& SourceFrame, const FROSTime& Time,
+	ROSMessages::geometry_msgs::TransformStamped& Transform) const
+{
+	FScopeLock Lock(&Mutex);
+
+	const int32 Target = FindFrame(TargetFrame);
+	const int32 Source = FindFrame(SourceFrame);
+	if (Target == INDEX_NONE || Source == INDEX_NONE) return false;
+
+	int64 Stamp = ToStamp(Time);
+	FPose Result;
+	if (!LookupPose(Target, Source, Stamp, Result)) return false;
+
+	Transform.header.time = ToROSTime(Stamp);
+	Transform.header.frame_id = Frames[Target].Name;
+	Transform.child_frame_id = Frames[Source].Name;
+	Transform.transform.translation.x = Result.X;
+	Transform.transform.translation.y = Result.Y;
+	Transform.transform.translation.z = Result.Z;
+	Transform.transform.rotation.x = Result.QX;
+	Transform.transform.rotation.y = Result.QY;
+	Transform.transform.rotation.z = Result.QZ;
+	Transform.transform.rotation.w = Result.QW;
+	return true;
+}
+
+bool UTFBuffer::LookupTransform(const FString& TargetFrame, const FString& SourceFrame, const FROSTime& Time,
+	ROSMessages::geometry_msgs::Transform& Transform, FROSTime& Stamp) const
+{
+	FScopeLock Lock(&Mutex);
+
+	const int32 Target = FindFrame(TargetFrame);
+	const int32 Source = FindFrame(SourceFrame);
+	if (Target == INDEX_NONE || Source == INDEX_NONE) return false;
+
+	int64 ResultStamp = ToStamp(Time);
+	FPose Result;
+	if (!LookupPose(Target, Source, ResultStamp, Result)) return false;
+
+	Stamp = ToROSTime(ResultStamp);
+	Transform.translation.x = Result.X;
+	Transform.translation.y = Result.Y;
+	Transform.translation.z = Result.Z;
+	Transform.rotation.x = Result.QX;
+	Transform.rotation.y = Result.QY;
+	Transform.rotation.z = Result.QZ;
+	Transform.rotation.w = Result.QW;
+	return true;
+}
+
+bool UTFBuffer::LookupPose(int32 Target, int32 Source, int64& Stamp, FPose& Result) const
+{
+	const FChain* Chain = FindChain(Target, Source);
+	if (!Chain) return false;
+
+	if (Stamp == 0 && !GetLatestCommonStamp(*Chain, Stamp)) return false;
+
+	// both paths end at the common ancestor, the target path is walked backwards
+	FPose SourceToAncestor, TargetToAncestor, Pose;
+	for (int32 Frame : Chain->SourcePath) {
+		if (!InterpolateFrame(Frames[Frame], Stamp, Pose)) return false;
+		SourceToAncestor = Compose(Pose, SourceToAncestor);
+	}
+	for (int32 Frame : Chain->TargetPath) {
+		if (!InterpolateFrame(Frames[Frame], Stamp, Pose)) return false;
+		TargetToAncestor = Compose(Pose, TargetToAncestor);
+	}
+	Result = Compose(Inverse(TargetToAncestor), SourceToAncestor);
+	return true;
+}
+
+bool UTFBuffer::CanTransform(const FString& TargetFrame, const FString& SourceFrame, const FROSTime& Time) const
+{
+	FScopeLock Lock(&Mutex);
+
+	const int32 Target = FindFrame(TargetFrame);
+	const int32 Source = FindFrame(SourceFrame);
+	if (Target == INDEX_NONE || Source == INDEX_NONE) return false;
+
+	int64 Stamp = ToStamp(Time);
+	FPose Result;
+	return LookupPose(Target, Source, Stamp, Result);
+}
+
+TArray<FString> UTFBuffer::GetFrames() const
+{
+	FScopeLock Lock(&Mutex);
+
+	TArray<FString> Names;
+	Names.Reserve(Frames.Num());
+	for (const FFrame& Frame : Frames) {
+		Names.Add(Frame.Name);
+	}
+	return Names;
+}
+
+void UTFBuffer::Clear()
+{
+	FScopeLock Lock(&Mutex);
+
+	Frames.Empty();
+	FrameIndices.Empty();
+	Chains.Empty();
+	++Generation;
+}
+
+FString UTFBuffer::NormalizeFrameName(const FString& Frame)
+{
+	// tf2 ignores a leading slash
+	return Frame.StartsWith(TEXT("/")) ? Frame.RightChop(1) : Frame;
+}
+
+int32 UTFBuffer::FindFrame(const FString& Frame) const
+{
+	// names without a leading slash are looked up without copying them
+	const int32* Index = Frame.StartsWith(TEXT("/")) ? FrameIndices.Find(NormalizeFrameName(Frame)) : FrameIndices.Find(Frame);
+	return Index ? *Index : INDEX_NONE;
+}
+
+int32 UTFBuffer::FindOrAddFrame(const FString& Frame)
+{
+	if (const int32* Index = FrameIndices.Find(Frame)) {
+		return *Index;
+	}
+	const int32 Index = Frames.AddDefaulted();
+	Frames[Index].Name = Frame;
+	FrameIndices.Add(Frame, Index);
+	return Index;
+}
+
+const UTFBuffer::FChain* UTFBuffer::FindChain(int32 Target, int32 Source) const
+{
+	const uint64 Key = ((uint64)(uint32)Target << 32) | (uint32)Source;
+
+	// all chains are stale once the frame tree has changed, so they are dropped instead of resolved again one by one
+	if (ChainsGeneration != Generation || (Chains.Num() >= MaxChains && !Chains.Contains(Key))) {
+		Chains.Reset();
+		ChainsGeneration = Generation;
+	}
+
+	FChain& Chain = Chains.FindOrAdd(Key);
+	if (Chain.Generation == Generation) {
+		return &Chain;
+	}
+	Chain.Generation = 0;
+	Chain.SourcePath.Reset();
+	Chain.TargetPath.Reset();
+
+	for (int32 Frame = Source; Frame != INDEX_NONE; Frame = Frames[Frame].Parent) {
+		if (Chain.SourcePath.Num() >= MaxFrameTreeDepth) return nullptr;
+		Chain.SourcePath.Add(Frame);
+	}
+
+	for (int32 Frame = Target; Frame != INDEX_NONE; Frame = Frames[Frame].Parent) {
+		const int32 Common = Chain.SourcePath.Find(Frame);
+		if (Common != INDEX_NONE) {
+			Chain.SourcePath.SetNum(Common);
+			Chain.Generation = Generation;
+			return &Chain;
+		}
+		if (Chain.TargetPath.Num() >= MaxFrameTreeDepth) return nullptr;
+		Chain.TargetPath.Add(Frame);
+	}
+
+	// the frames are in different trees
+	return nullptr;
+}
+
+bool UTFBuffer::GetLatestCommonStamp(const FChain& Chain, int64& Stamp) const
+{
+	// static transforms are valid at any time, so a chain of only static transforms keeps a zero stamp
+	bool bHasDynamicFrame = false;
+	int64 Latest = MAX_int64;
+	for (const TArray<int32>* Path : { &Chain.SourcePath, &Chain.TargetPath }) {
+		for (int32 Index : *Path) {
+			const FFrame& Frame = Frames[Index];
+			if (Frame.bStatic) continue;
+			if (Frame.Num == 0) return false;
+
+			Latest = FMath::Min(Latest, Frame.Sample(Frame.Num - 1).Stamp);
+			bHasDynamicFrame = true;
+		}
+	}
+	Stamp = bHasDynamicFrame ? Latest : 0;
+	return true;
+}
+
+bool UTFBuffer::InterpolateFrame(const FFrame& Frame, int64 Stamp, FPose& Result) const
+{
+	if (Frame.Num == 0) return false;
+
+	if (Frame.bStatic) {
+		Result = Frame.Sample(0).Pose;
+		return true;
+	}
+
+	// no extrapolation
+	if (Stamp < Frame.Sample(0).Stamp || Stamp > Frame.Sample(Frame.Num - 1).Stamp) return false;
+
+	// first sample that isn't older
+	int32 Low = 0, High = Frame.Num - 1;
+	while (Low < High) {
+		const int32 Mid = (Low + High) / 2;
+		if (Frame.Sample(Mid).Stamp < Stamp) Low = Mid + 1;
+		else High = Mid;
+	}
+
+	const FSample& After = Frame.Sample(Low);
+	if (After.Stamp == Stamp) {
+		Result = After.Pose;
+		return true;
+	}
+	const FSample& Before = Frame.Sample(Low - 1);
+	Result = Interpolate(Before.Pose, After.Pose, (double)(Stamp - Before.Stamp) / (double)(After.Stamp - Before.Stamp));
+	return true;
+}
+
+UTFBuffer::FPose UTFBuffer::Compose(const FPose& A, const FPose& B)
+{
+	FPose Result;
+
+	// rotation of B's translation by A: v + 2w(u x v) + 2u x (u x v), u being the vector part of A's rotation
+	const double TX = 2.0 * (A.QY * B.Z - A.QZ * B.Y);
+	const double TY = 2.0 * (A.QZ * B.X - A.QX * B.Z);
+	const double TZ = 2.0 * (A.QX * B.Y - A.QY * B.X);
+	Result.X = B.X + A.QW * TX + (A.QY * TZ - A.QZ * TY) + A.X;
+	Result.Y = B.Y + A.QW * TY + (A.QZ * TX - A.QX * TZ) + A.Y;
+	Result.Z = B.Z + A.QW * TZ + (A.QX * TY - A.QY * TX) + A.Z;
+
+	Result.QW = A.QW * B.QW - A.QX * B.QX - A.QY * B.QY - A.QZ * B.QZ;
+	Result.QX = A.QW * B.QX + A.QX * B.QW + A.QY * B.QZ - A.QZ * B.QY;
+	Result.QY = A.QW * B.QY - A.QX * B.QZ + A.QY * B.QW + A.QZ * B.QX;
+	Result.QZ = A.QW * B.QZ + A.QX * B.QY - A.QY * B.QX + A.QZ * B.QW;
+	return Result;
+}
+
+UTFBuffer::FPose UTFBuffer::Inverse(const FPose& Pose)
+{
+	FPose Conjugate;
+	Conjugate.QX = -Pose.QX;
+	Conjugate.QY = -Pose.QY;
+	Conjugate.QZ = -Pose.QZ;
+	Conjugate.QW = Pose.QW;
+
+	FPose Translation;
+	Translation.X = -Pose.X;
+	Translation.Y = -Pose.Y;
+	Translation.Z = -Pose.Z;
+	return Compose(Conjugate, Translation);
+}
+
+UTFBuffer::FPose UTFBuffer::Interpolate(const FPose& A, const FPose& B, double Alpha)
+{
+	FPose Result;
+	Result.X = A.X + (B.X - A.X) * Alpha;
+	Result.Y = A.Y + (B.Y - A.Y) * Alpha;
+	Result.Z = A.Z + (B.Z - A.Z) * Alpha;
+
+	// q and -q are the same rotation, take the shorter arc
+	double Dot = A.QX * B.QX + A.QY * B.QY + A.QZ * B.QZ + A.QW * B.QW;
+	const double Sign = Dot < 0.0 ? -1.0 : 1.0;
+	Dot *= Sign;
+
+	double WeightA = 1.0 - Alpha;
+	double WeightB = Alpha * Sign;
+	if (Dot < 0.9995) {
+		const double Angle = FMath::Acos(Dot);
+		const double SinAngle = FMath::Sin(Angle);
+		WeightA = FMath::Sin((1.0 - Alpha) * Angle) / SinAngle;
+		WeightB = FMath::Sin(Alpha * Angle) / SinAngle * Sign;
+	}
+
+	Result.QX = WeightA * A.QX + WeightB * B.QX;
+	Result.QY = WeightA * A.QY + WeightB * B.QY;
+	Result.QZ = WeightA * A.QZ + WeightB * B.QZ;
+	Result.QW = WeightA * A.QW + WeightB * B.QW;
+
+	// nearly parallel rotations are lerped, which needs normalizing
+	const double Norm = FMath::Sqrt(Result.QX * Result.QX + Result.QY * Result.QY + Result.QZ * Result.QZ + Result.QW * Result.QW);
+	Result.QX /= Norm;
+	Result.QY /= Norm;
+	Result.QZ /= Norm;
+	Result.QW /= Norm;
+	return Result;
+}
@@ -0,0 +1,78 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Conversion/Messages/BaseMessageConverter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBSONArrayDecodeTest, "ROSIntegration.Conversion.ArrayDecode",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace
+{
+	// {msg: {data: [0.0, 1.0, ...]}}
+	bson_t* MakeArrayMessage(int32 Num)
+	{
+		bson_t* Message = bson_new();
+		bson_t Msg, Data;
+		BSON_APPEND_DOCUMENT_BEGIN(Message, "msg", &Msg);
+		BSON_APPEND_ARRAY_BEGIN(&Msg, "data", &Data);
+		char KeyBuffer[16];
+		const char* Key;
+		for (int32 i = 0; i < Num; ++i)
+		{
+			bson_uint32_to_string(i, &Key, KeyBuffer, sizeof KeyBuffer);
+			BSON_APPEND_DOUBLE(&Data, Key, i);
+		}
+		bson_append_array_end(&Msg, &Data);
+		bson_append_document_end(Message, &Msg);
+		return Message;
+	}
+
+	// Decodes the array of Message, returns the seconds per element
+	template<class FDecode>
+	double TimeDecode(FAutomationTestBase& Test, const TCHAR* Path, int32 Num, bson_t* Message, FDecode Decode)
+	{
+		bool KeyFound = false;
+		const double Start = FPlatformTime::Seconds();
+		TArray<double> Values = Decode(Message, KeyFound);
+		const double Seconds = FPlatformTime::Seconds() - Start;
+
+		Test.TestTrue(FString::Printf(TEXT("%s finds %d elements"), Path, Num), KeyFound && Values.Num() == Num);
+		Test.TestTrue(FString::Printf(TEXT("%s reads the last of %d elements"), Path, Num), Values.Num() == Num && Values.Last() == Num - 1);
+		Test.AddInfo(FString::Printf(TEXT("%s: %d elements in %.3f ms"), Path, Num, Seconds * 1000.0));
+		return Seconds / Num;
+	}
+}
+
+// Decodes arrays of 1e3, 1e5 and 1e7 doubles with the single-pass and the key-based decoder.
+// Both have to scale linearly, the former lookup of every element from the root of the message took minutes for 1e5.
+bool FBSONArrayDecodeTest::RunTest(const FString& Parameters)
+{
+	const int32 Sizes[] = { 1000, 100000, 10000000 };
+	double SinglePassSeconds[3] = { 0 };
+	double KeyBasedSeconds[3] = { 0 };
+
+	for (int32 i = 0; i < 3; ++i)
+	{
+		bson_t* Message = MakeArrayMessage(Sizes[i]);
+
+		SinglePassSeconds[i] = TimeDecode(*this, TEXT("GetDoubleTArrayFromBSON"), Sizes[i], Message, [](bson_t* Msg, bool& KeyFound) {
+			return UBaseMessageConverter::GetDoubleTArrayFromBSON(TEXT("msg.data"), Msg, KeyFound);
+		});
+		KeyBasedSeconds[i] = TimeDecode(*this, TEXT("GetTArrayFromBSON"), Sizes[i], Message, [](bson_t* Msg, bool& KeyFound) {
+			return UBaseMessageConverter::GetTArrayFromBSON<double>(TEXT("msg.data"), Msg, KeyFound, [](FString Key, bson_t* Element, bool& ElementFound) {
+				return UBaseMessageConverter::GetDoubleFromBSON(Key, Element, ElementFound);
+			});
+		});
+
+		bson_destroy(Message);
+	}
+
+	// 100 times the elements take 100 times as long, quadratic decoding would take 10000 times as long.
+	// The bound leaves room for cache effects of the large array.
+	TestTrue(TEXT("GetDoubleTArrayFromBSON decodes in linear time"), SinglePassSeconds[2] < 10.0 * SinglePassSeconds[1]);
+	TestTrue(TEXT("GetTArrayFromBSON decodes in linear time"), KeyBasedSeconds[2] < 10.0 * KeyBasedSeconds[1]);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,75 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include <UObject/UObjectIterator.h>
+#include "Conversion/ConverterRegistry.h"
+#include "Conversion/Messages/BaseMessageConverter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConverterRegistryLookupTest, "ROSIntegration.Conversion.ConverterLookup",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace
+{
+	// The former lookup of the first UTopic::Init, which walked every loaded class to collect the converters
+	TMap<FString, UBaseMessageConverter*> ScanMessageConverters()
+	{
+		TMap<FString, UBaseMessageConverter*> Converters;
+		for (TObjectIterator<UClass> It; It; ++It)
+		{
+			UClass* ClassItr = *It;
+			if (ClassItr->IsChildOf(UBaseMessageConverter::StaticClass()) && ClassItr != UBaseMessageConverter::StaticClass())
+			{
+				UBaseMessageConverter* ConcreteConverter = ClassItr->GetDefaultObject<UBaseMessageConverter>();
+				Converters.Add(ConcreteConverter->_MessageType, ConcreteConverter);
+			}
+		}
+		return Converters;
+	}
+}
+
+// Times FConverterRegistry::FindMessageConverter against the scan over all loaded classes that it replaced.
+// Both have to find the same converter.
+bool FConverterRegistryLookupTest::RunTest(const FString& Parameters)
+{
+	const FName MessageType(TEXT("sensor_msgs/Imu"));
+	FConverterRegistry& Registry = FConverterRegistry::Get();
+
+	// the tables are usually built at module startup, a lookup builds them otherwise
+	UBaseMessageConverter* Found = Registry.FindMessageConverter(MessageType);
+	TestNotNull(TEXT("the registry finds the sensor_msgs/Imu converter"), Found);
+
+	int32 NumClasses = 0;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		++NumClasses;
+	}
+
+	const int32 NumScans = 10;
+	UBaseMessageConverter* Scanned = nullptr;
+	double Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumScans; ++i)
+	{
+		const TMap<FString, UBaseMessageConverter*> Converters = ScanMessageConverters();
+		UBaseMessageConverter* const* Converter = Converters.Find(MessageType.ToString());
+		Scanned = Converter ? *Converter : nullptr;
+	}
+	const double ScanSeconds = (FPlatformTime::Seconds() - Start) / NumScans;
+	TestTrue(TEXT("the scan finds the same converter"), Scanned == Found);
+
+	const int32 NumLookups = 100000;
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumLookups; ++i)
+	{
+		Found = Registry.FindMessageConverter(MessageType);
+	}
+	const double LookupSeconds = (FPlatformTime::Seconds() - Start) / NumLookups;
+	TestTrue(TEXT("repeated lookups find the same converter"), Found == Scanned);
+
+	AddInfo(FString::Printf(TEXT("Scanning %d classes took %.3f ms, a registry lookup takes %.0f ns"),
+		NumClasses, ScanSeconds * 1000.0, LookupSeconds * 1e9));
+	TestTrue(TEXT("a registry lookup is faster than a scan"), LookupSeconds < ScanSeconds);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
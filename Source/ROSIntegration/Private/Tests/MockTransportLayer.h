@@ -0,0 +1,63 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include "rosbridge2cpp/itransport_layer.h"
+
+/**
+ * Transport layer for tests, which accepts every message without a connection.
+ * Incoming frames are passed to the bridge with Receive(), like the receiver thread of TCPConnection does.
+ */
+class FMockTransportLayer : public rosbridge2cpp::ITransportLayer
+{
+public:
+	bool Init(std::string, int) override { return true; }
+
+	bool SendMessage(std::string) override
+	{
+		++NumSentMessages;
+		return true;
+	}
+
+	bool SendMessage(const uint8_t* Data, unsigned int Length) override
+	{
+		if (OnSend) OnSend(Data, Length);
+		++NumSentMessages;
+		return true;
+	}
+
+	void RegisterIncomingMessageCallback(std::function<void(rosbridge2cpp::json&)>) override {}
+
+	void RegisterIncomingMessageCallback(std::function<void(bson_t&)> Callback) override
+	{
+		std::lock_guard<std::mutex> Lock(CallbackMutex);
+		IncomingMessageCallback = Callback;
+	}
+
+	void UnregisterIncomingMessageCallbacks() override
+	{
+		std::lock_guard<std::mutex> Lock(CallbackMutex);
+		IncomingMessageCallback = nullptr;
+	}
+
+	void RegisterErrorCallback(std::function<void(rosbridge2cpp::TransportError)>) override {}
+	void ReportError(rosbridge2cpp::TransportError) override {}
+	void SetTransportMode(TransportMode) override {}
+
+	void Receive(bson_t& Frame)
+	{
+		std::lock_guard<std::mutex> Lock(CallbackMutex);
+		if (IncomingMessageCallback) IncomingMessageCallback(Frame);
+	}
+
+	// Called on the sending thread for every BSON message, set it before the bridge is initialized
+	std::function<void(const uint8_t*, unsigned int)> OnSend;
+
+	std::atomic<int64> NumSentMessages{ 0 };
+
+private:
+	std::mutex CallbackMutex;
+	std::function<void(bson_t&)> IncomingMessageCallback;
+};
@@ -0,0 +1,143 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "rosbridge2cpp/ros_bridge.h"
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPublisherQueueContentionTest, "ROSIntegration.Rosbridge.PublisherQueueContention",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace
+{
+	using rosbridge2cpp::OutgoingMessage;
+
+	// The former publisher queue, a std::queue guarded by a lock that producers and the queue thread share
+	class FLockedPublisherQueue
+	{
+	public:
+		explicit FLockedPublisherQueue(size_t InQueueSize) : QueueSize(InQueueSize) {}
+
+		~FLockedPublisherQueue()
+		{
+			OutgoingMessage* Message;
+			while (Pop(Message)) delete Message;
+		}
+
+		int Push(OutgoingMessage* Message)
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			int NumDropped = 0;
+			while (Messages.size() >= QueueSize)
+			{
+				delete Messages.front();
+				Messages.pop();
+				++NumDropped;
+			}
+			Messages.push(Message);
+			return NumDropped;
+		}
+
+		bool Pop(OutgoingMessage*& Message)
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			if (Messages.empty()) return false;
+			Message = Messages.front();
+			Messages.pop();
+			return true;
+		}
+
+	private:
+		std::mutex Mutex;
+		std::queue<OutgoingMessage*> Messages;
+		size_t QueueSize;
+	};
+
+	const int32 NumProducers = 8;
+	const int32 MessagesPerProducer = 20000;
+	const int32 QueueSize = 1024;
+
+	// Pushes from NumProducers threads while one consumer pops, like the publisher queue thread.
+	// Returns the seconds until all messages have been pushed and popped.
+	template<class QueueType>
+	double MeasureContention(FAutomationTestBase& Test, const TCHAR* Name, QueueType& Queue)
+	{
+		// allocated up front, so the producers only contend for the queue
+		std::vector<std::vector<OutgoingMessage*>> Messages(NumProducers);
+		for (std::vector<OutgoingMessage*>& ProducerMessages : Messages)
+		{
+			for (int32 i = 0; i < MessagesPerProducer; ++i)
+			{
+				ProducerMessages.push_back(new OutgoingMessage(bson_new()));
+			}
+		}
+
+		std::atomic<int32> NumRunningProducers{ NumProducers };
+		std::atomic<int64> NumDropped{ 0 };
+		int64 NumPopped = 0;
+
+		const double Start = FPlatformTime::Seconds();
+		std::vector<std::thread> Producers;
+		for (int32 p = 0; p < NumProducers; ++p)
+		{
+			Producers.emplace_back([&, p] {
+				int64 Dropped = 0;
+				for (OutgoingMessage* Message : Messages[p])
+				{
+					Dropped += Queue.Push(Message);
+				}
+				NumDropped += Dropped;
+				--NumRunningProducers;
+			});
+		}
+
+		OutgoingMessage* Message;
+		for (;;)
+		{
+			const bool bProducersDone = NumRunningProducers == 0;
+			if (Queue.Pop(Message))
+			{
+				delete Message;
+				++NumPopped;
+			}
+			else if (bProducersDone)
+			{
+				break;
+			}
+		}
+		for (std::thread& Producer : Producers)
+		{
+			Producer.join();
+		}
+		const double Seconds = FPlatformTime::Seconds() - Start;
+
+		Test.TestEqual(FString::Printf(TEXT("%s: every message is either sent or dropped"), Name),
+			NumPopped + NumDropped.load(), (int64)NumProducers * MessagesPerProducer);
+		Test.AddInfo(FString::Printf(TEXT("%s: %d producers pushed %d messages in %.1f ms (%.0f ns per message), %lld dropped"),
+			Name, NumProducers, NumProducers * MessagesPerProducer, Seconds * 1000.0,
+			Seconds * 1e9 / (NumProducers * MessagesPerProducer), NumDropped.load()));
+		return Seconds;
+	}
+}
+
+// Every publish used to take the lock of the publisher queues, which the queue thread took on every iteration as well.
+// Compares the lock-free ring of PublisherQueue with that queue, 8 producer threads and one consumer each.
+bool FPublisherQueueContentionTest::RunTest(const FString& Parameters)
+{
+	rosbridge2cpp::PublisherQueue RingQueue(QueueSize, rosbridge2cpp::PublisherPriority::NORMAL);
+	const double RingSeconds = MeasureContention(*this, TEXT("lock-free ring"), RingQueue);
+
+	FLockedPublisherQueue LockedQueue(QueueSize);
+	const double LockedSeconds = MeasureContention(*this, TEXT("locked queue"), LockedQueue);
+
+	// Only reported, the ratio depends on the number of cores. With a single core the threads don't contend,
+	// they are just scheduled one after the other.
+	AddInfo(FString::Printf(TEXT("The ring takes %.2f times as long as the locked queue"), RingSeconds / LockedSeconds));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,131 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "rosbridge2cpp/ros_bridge.h"
+#include "MockTransportLayer.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPublisherQueueLatencyTest, "ROSIntegration.Rosbridge.PublisherQueueLatency",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace
+{
+	const double WaitTimeout = 10.0;
+
+	bson_t* MakePublishMessage(const std::string& Topic, int32 Value)
+	{
+		return BCON_NEW("op", "publish", "topic", BCON_UTF8(Topic.c_str()), "msg", "{", "data", BCON_INT32(Value), "}");
+	}
+
+	// Returns false if the queue thread doesn't send Num messages in time
+	bool WaitForSentMessages(const FMockTransportLayer& Transport, int64 Num)
+	{
+		const double Deadline = FPlatformTime::Seconds() + WaitTimeout;
+		while (Transport.NumSentMessages < Num)
+		{
+			if (FPlatformTime::Seconds() > Deadline) return false;
+			std::this_thread::yield();
+		}
+		return true;
+	}
+
+	// Queues one message at a time and waits until it is sent, so the queue thread is idle before every message.
+	// Returns the 99th percentile of the enqueue-to-send latency in seconds.
+	double MeasureLatency(FAutomationTestBase& Test, int32 NumTopics)
+	{
+		FMockTransportLayer Transport;
+		rosbridge2cpp::ROSBridge Bridge(Transport, true);
+		Bridge.Init("", 0);
+
+		std::vector<std::shared_ptr<rosbridge2cpp::PublisherQueue>> Queues;
+		std::vector<std::string> Topics;
+		for (int32 i = 0; i < NumTopics; ++i)
+		{
+			Topics.push_back("/latency_" + std::to_string(i));
+			Queues.push_back(Bridge.GetPublisherQueue(Topics.back(), 10));
+		}
+
+		const int32 NumMessages = 2000;
+		std::vector<double> Latencies;
+		Latencies.reserve(NumMessages);
+		for (int32 i = 0; i < NumMessages; ++i)
+		{
+			bson_t* Message = MakePublishMessage(Topics[i % NumTopics], i);
+			const double Start = FPlatformTime::Seconds();
+			Bridge.QueueMessage(*Queues[i % NumTopics], Message);
+			if (!WaitForSentMessages(Transport, i + 1))
+			{
+				Test.AddError(FString::Printf(TEXT("Message %d of %d topics has not been sent"), i, NumTopics));
+				return WaitTimeout;
+			}
+			Latencies.push_back(FPlatformTime::Seconds() - Start);
+		}
+
+		std::sort(Latencies.begin(), Latencies.end());
+		const double P99 = Latencies[NumMessages * 99 / 100];
+		Test.AddInfo(FString::Printf(TEXT("%d topics: enqueue-to-send latency median %.1f us, p99 %.1f us"),
+			NumTopics, Latencies[NumMessages / 2] * 1e6, P99 * 1e6));
+		return P99;
+	}
+
+	// Queues messages round robin over the topics as fast as the queue thread sends them.
+	// Returns the messages sent per second.
+	double MeasureThroughput(FAutomationTestBase& Test, int32 NumTopics)
+	{
+		FMockTransportLayer Transport;
+		rosbridge2cpp::ROSBridge Bridge(Transport, true);
+		Bridge.Init("", 0);
+
+		std::vector<std::shared_ptr<rosbridge2cpp::PublisherQueue>> Queues;
+		std::vector<std::string> Topics;
+		for (int32 i = 0; i < NumTopics; ++i)
+		{
+			Topics.push_back("/throughput_" + std::to_string(i));
+			Queues.push_back(Bridge.GetPublisherQueue(Topics.back(), 1000));
+		}
+
+		// stays below the queue size, so no message is dropped
+		const int64 MaxInFlight = 500;
+		const int32 NumMessages = 20000;
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumMessages; ++i)
+		{
+			if (!WaitForSentMessages(Transport, i - MaxInFlight))
+			{
+				Test.AddError(FString::Printf(TEXT("The queue thread stalled with %d topics"), NumTopics));
+				return 0;
+			}
+			Bridge.QueueMessage(*Queues[i % NumTopics], MakePublishMessage(Topics[i % NumTopics], i));
+		}
+		if (!WaitForSentMessages(Transport, NumMessages))
+		{
+			Test.AddError(FString::Printf(TEXT("Not all messages of %d topics have been sent"), NumTopics));
+			return 0;
+		}
+		const double MessagesPerSecond = NumMessages / (FPlatformTime::Seconds() - Start);
+
+		Test.AddInfo(FString::Printf(TEXT("%d topics: %.0f messages/s"), NumTopics, MessagesPerSecond));
+		return MessagesPerSecond;
+	}
+}
+
+// The publisher queue thread used to sleep 10 ms after every pass over the queues, which added up to 10 ms of latency
+// to every message and capped a topic at 100 messages/s. It is woken up by QueueMessage now.
+bool FPublisherQueueLatencyTest::RunTest(const FString& Parameters)
+{
+	for (int32 NumTopics : { 1, 50 })
+	{
+		const double P99 = MeasureLatency(*this, NumTopics);
+		const double MessagesPerSecond = MeasureThroughput(*this, NumTopics);
+
+		// loose bounds for loaded machines, the polling loop missed both by an order of magnitude
+		TestTrue(FString::Printf(TEXT("p99 latency with %d topics is below 5 ms"), NumTopics), P99 < 0.005);
+		TestTrue(FString::Printf(TEXT("%d topics send more than 1000 messages/s"), NumTopics), MessagesPerSecond > 1000.0);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
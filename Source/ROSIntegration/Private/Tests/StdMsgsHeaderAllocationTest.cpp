@@ -0,0 +1,102 @@
+#include "Misc/AutomationTest.h"
+#include "Conversion/Messages/std_msgs/StdMsgsHeaderConverter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStdMsgsHeaderAllocationTest, "ROSIntegration.Conversion.HeaderAllocation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace
+{
+	// Counts the libbson allocations of this thread, other threads keep using libbson while the vtable is set
+	thread_local int32 NumBSONAllocations = 0;
+
+	void* CountingMalloc(size_t NumBytes)
+	{
+		++NumBSONAllocations;
+		return malloc(NumBytes);
+	}
+
+	void* CountingCalloc(size_t NumMembers, size_t NumBytes)
+	{
+		++NumBSONAllocations;
+		return calloc(NumMembers, NumBytes);
+	}
+
+	void* CountingRealloc(void* Mem, size_t NumBytes)
+	{
+		++NumBSONAllocations;
+		return realloc(Mem, NumBytes);
+	}
+
+	void CountingFree(void* Mem)
+	{
+		free(Mem);
+	}
+}
+
+// _bson_append_header writes the header in place, so it must not allocate as long as the parent document has room.
+// The UTF-8 bytes of frame_id are cached, so a long frame_id, which doesn't fit the stack buffer of FTCHARToUTF8,
+// is converted only once as well. The header has to be the same document as building it with BCON_NEW and appending it.
+bool FStdMsgsHeaderAllocationTest::RunTest(const FString& Parameters)
+{
+	const ROSMessages::std_msgs::Header Headers[] = {
+		ROSMessages::std_msgs::Header(42, FROSTime(1234, 5678), TEXT("base_link")),
+		ROSMessages::std_msgs::Header(43, FROSTime(1234, 5678), FString::ChrN(300, TEXT('f'))),
+		ROSMessages::std_msgs::Header(44, FROSTime(1234, 5678), TEXT("")),
+	};
+
+	// the bundled libbson doesn't export bson_mem_restore_vtable, its default vtable is the C allocator
+	bson_mem_vtable_t DefaultVTable = { malloc, calloc, realloc, free };
+	bson_mem_vtable_t CountingVTable = { CountingMalloc, CountingCalloc, CountingRealloc, CountingFree };
+
+	for (const ROSMessages::std_msgs::Header& Header : Headers)
+	{
+		// reserved before counting, the parent only grows if it is too small for the header
+		bson_t* Message = bson_sized_new(1024);
+		UStdMsgsHeaderConverter::_bson_append_header(Message, &Header);
+
+		const uint64 Conversions = UStdMsgsHeaderConverter::_num_frame_id_conversions();
+		bson_mem_set_vtable(&CountingVTable);
+		NumBSONAllocations = 0;
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			bson_reinit(Message);
+			UStdMsgsHeaderConverter::_bson_append_header(Message, &Header);
+		}
+		const int32 Allocations = NumBSONAllocations;
+		bson_mem_set_vtable(&DefaultVTable);
+
+		TestEqual(FString::Printf(TEXT("libbson allocations of 1000 headers with a frame_id of %d characters"), Header.frame_id.Len()), Allocations, 0);
+		TestEqual(FString::Printf(TEXT("conversions of a cached frame_id of %d characters"), Header.frame_id.Len()),
+			UStdMsgsHeaderConverter::_num_frame_id_conversions() - Conversions, (uint64)0);
+
+		bson_t* Reference = BCON_NEW(
+			"header", "{",
+				"seq", BCON_INT32(Header.seq),
+				"stamp", "{",
+					"secs", BCON_INT32(Header.time._Sec),
+					"nsecs", BCON_INT32(Header.time._NSec),
+				"}",
+				"frame_id", BCON_UTF8(TCHAR_TO_UTF8(*Header.frame_id)),
+			"}");
+		TestTrue(FString::Printf(TEXT("header with a frame_id of %d characters is written like the BCON document"), Header.frame_id.Len()),
+			Message->len == Reference->len && memcmp(bson_get_data(Message), bson_get_data(Reference), Message->len) == 0);
+
+		bson_destroy(Reference);
+		bson_destroy(Message);
+	}
+
+	// frame_ids are case-sensitive, "Base_Link" must not reuse the bytes of "base_link"
+	const ROSMessages::std_msgs::Header Other(45, FROSTime(1234, 5678), TEXT("Base_Link"));
+	bson_t* Message = bson_new();
+	UStdMsgsHeaderConverter::_bson_append_header(Message, &Other);
+	bson_iter_t Iter;
+	TestTrue(TEXT("frame_ids that only differ in case are cached separately"),
+		bson_iter_init(&Iter, Message) && bson_iter_find_descendant(&Iter, "header.frame_id", &Iter)
+		&& FCStringAnsi::Strcmp(bson_iter_utf8(&Iter, nullptr), "Base_Link") == 0);
+	bson_destroy(Message);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
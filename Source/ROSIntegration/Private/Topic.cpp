@@ -2,10 +2,11 @@
 #include <bson.h>
 #include "rosbridge2cpp/ros_bridge.h"
 #include "rosbridge2cpp/ros_topic.h"
+#include "Conversion/ConverterRegistry.h"
+#include "SharedSubscriptions.h"
 #include "Conversion/Messages/BaseMessageConverter.h"
 #include "Conversion/Messages/std_msgs/StdMsgsStringConverter.h"
 
-static TMap<FString, UBaseMessageConverter*> TypeConverterMap;
 static TMap<EMessageType, FString> SupportedMessageTypes;
 
 
@@ -22,9 +23,8 @@ public:
 
 	~Impl() {
 
-		if (_Callback && _Ric) {
-			Unsubscribe();
-		}
+		// without the connection, only the listener is removed
+		FSharedSubscriptions::Get().Unsubscribe(_Subscription, _Ric != nullptr);
 
 		if(_ROSTopic) delete _ROSTopic;
 	}
@@ -33,36 +33,57 @@ public:
 	FString _Topic;
 	FString _MessageType;
 	int32 _QueueSize;
+	ETopicPriority _Priority;
+	bool _bLatch = false;
+	ETopicQueuePolicy _QueuePolicy = ETopicQueuePolicy::None;
 	rosbridge2cpp::ROSTopic* _ROSTopic = nullptr;
 	UBaseMessageConverter* _Converter;
-	rosbridge2cpp::ROSCallbackHandle<rosbridge2cpp::FunVrROSPublishMsg> _CallbackHandle;
 
 	std::function<void(TSharedPtr<FROSBaseMsg>)> _Callback;
+	std::function<void(const ROSBridgePublishMsg&)> _EncodedCallback;
+
+	// Listener of the subscription that all UTopics of the same topic and message type share,
+	// _ROSTopic is only used for publishing
+	FSharedSubscriptions::FHandle _Subscription;
 
-	bool ConvertMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t** message)
+	// Messages with a fixed layout are only patched into the last encoded one
+	FBSONMessageTemplate _Template;
+
+	bool ConvertMessage(TSharedPtr<FROSBaseMsg> BaseMsg, bson_t* message)
 	{
-		return _Converter->ConvertOutgoingMessage(BaseMsg, message);
+		// other messages are written straight into the outgoing message, without the copy and the lock of the template
+		if (!_Converter->SupportsTemplate()) {
+			return _Converter->AppendOutgoingMessage(BaseMsg, message);
+		}
+		return _Template.Append(_Converter, BaseMsg, message);
 	}
 
-	bool ConvertMessage(const ROSBridgePublishMsg* message, TSharedPtr<FROSBaseMsg> &BaseMsg)
+	bool IsSubscribed() const
 	{
-		return _Converter->ConvertIncomingMessage(message, BaseMsg);
+		return _Callback || _EncodedCallback;
 	}
 
-	bool Subscribe(std::function<void(TSharedPtr<FROSBaseMsg>)> func)
+	// Exactly one of func and EncodedFunc is set
+	bool Subscribe(std::function<void(TSharedPtr<FROSBaseMsg>)> func, std::function<void(const ROSBridgePublishMsg&)> EncodedFunc, ETopicQueuePolicy QueuePolicy)
 	{
 		if (!_ROSTopic) {
 			UE_LOG(LogROS, Error, TEXT("Rostopic hasn't been initialized before Subscribe() call"));
 			return false;
 		}
-		if (_Callback) {
+		if (IsSubscribed()) {
 			UE_LOG(LogROS, Warning, TEXT("Rostopic was already subscribed"));
 			Unsubscribe();
 		}
 
-		_CallbackHandle = _ROSTopic->Subscribe(std::bind(&UTopic::Impl::MessageCallback, this, std::placeholders::_1));
+		_QueuePolicy = QueuePolicy;
+		std::shared_ptr<FSharedSubscriptions::FListener> Listener = std::make_shared<FSharedSubscriptions::FListener>();
+		Listener->Callback = func;
+		Listener->EncodedCallback = EncodedFunc;
+		_Subscription = FSharedSubscriptions::Get().Subscribe(_Ric->_Implementation->Get()->_Ros, _Topic, _MessageType, _Converter,
+			_QueueSize, static_cast<rosbridge2cpp::ReceiveQueuePolicy>(QueuePolicy), Listener);
 		_Callback = func;
-		return _CallbackHandle.IsValid();
+		_EncodedCallback = EncodedFunc;
+		return _Subscription.IsValid();
 	}
 
 	bool Unsubscribe()
@@ -72,14 +93,9 @@ public:
 			return false;
 		}
 
-		bool result = _ROSTopic->Unsubscribe(_CallbackHandle);
-		if (result) {
-			_Callback = nullptr;
-			_CallbackHandle = rosbridge2cpp::ROSCallbackHandle<rosbridge2cpp::FunVrROSPublishMsg>();
-			if(_ROSTopic) delete _ROSTopic;
-			_ROSTopic = nullptr;
-		}
-		return result;
+		_Callback = nullptr;
+		_EncodedCallback = nullptr;
+		return FSharedSubscriptions::Get().Unsubscribe(_Subscription);
 	}
 
 	bool Advertise()
@@ -98,42 +114,48 @@ public:
 
 	bool Publish(TSharedPtr<FROSBaseMsg> msg)
 	{
-		bson_t *bson_message = nullptr;
-
-		if (ConvertMessage(msg, &bson_message)) {
-			return _ROSTopic->Publish(bson_message);
-			//bson_destroy(bson_message); // Not necessary, since bson memory will be freed in the rosbridge core code
-		}
-		else {
-			UE_LOG(LogROS, Error, TEXT("Failed to ConvertMessage in UTopic::Publish()"));
-			return false;
-		}
+		// The converter writes the message directly into the outgoing rosbridge message
+		return _ROSTopic->Publish([this, &msg](bson_t &message) {
+			if (!ConvertMessage(msg, &message)) {
+				UE_LOG(LogROS, Error, TEXT("Failed to ConvertMessage in UTopic::Publish()"));
+				return false;
+			}
+			return true;
+		});
 	}
 
-	void Init(UROSIntegrationCore *Ric, const FString& Topic, const FString& MessageType, int32 QueueSize)
+	bool PublishEncoded(TFunctionRef<bool(bson_t*)> AppendFields)
 	{
-		// Construct static ConverterMap
-		if (TypeConverterMap.Num() == 0)
-		{
-			for (TObjectIterator<UClass> It; It; ++It)
-			{
-				UClass* ClassItr = *It;
+		return _ROSTopic->Publish([&AppendFields](bson_t &message) {
+			if (!AppendFields(&message)) {
+				UE_LOG(LogROS, Error, TEXT("Failed to encode the message in UTopic::PublishEncoded()"));
+				return false;
+			}
+			return true;
+		});
+	}
 
-				if (It->IsChildOf(UBaseMessageConverter::StaticClass()) && *It != UBaseMessageConverter::StaticClass())
-				{
-					UBaseMessageConverter* ConcreteConverter = ClassItr->GetDefaultObject<UBaseMessageConverter>();
-					//UE_LOG(LogROS, Log, TEXT("Added %s with type %s to TopicConverterMap"), *(It->GetDefaultObjectName().ToString()), *(ConcreteConverter->_MessageType));
-					TypeConverterMap.Add(*(ConcreteConverter->_MessageType), ConcreteConverter);
-				}
+	bool PublishEncoded(TFunctionRef<bool(bson_t*)> AppendFields, TFunctionRef<bool(FBSONTemplateWriter&)> WriteValues)
+	{
+		return _ROSTopic->Publish([this, &AppendFields, &WriteValues](bson_t &message) {
+			if (!_Template.Append(_MessageType, AppendFields, WriteValues, &message)) {
+				UE_LOG(LogROS, Error, TEXT("Failed to encode the message in UTopic::PublishEncoded()"));
+				return false;
 			}
-		}
+			return true;
+		});
+	}
 
+	void Init(UROSIntegrationCore *Ric, const FString& Topic, const FString& MessageType, int32 QueueSize, ETopicPriority Priority, bool bLatch)
+	{
 		_Ric = Ric;
 		_Topic = Topic;
 		_MessageType = MessageType;
 		_QueueSize = QueueSize;
+		_Priority = Priority;
+		_bLatch = bLatch;
 
-		UBaseMessageConverter** Converter = TypeConverterMap.Find(MessageType);
+		UBaseMessageConverter* Converter = FConverterRegistry::Get().FindMessageConverter(FName(*MessageType));
 		if (!Converter)
 		{
 			UE_LOG(LogROS,
@@ -144,20 +166,12 @@ public:
 			       *Topic);
 			return;
 		}
-		_Converter = *Converter;
+		_Converter = Converter;
+		_Template.Reset();
 
-		_ROSTopic = new rosbridge2cpp::ROSTopic(Ric->_Implementation->Get()->_Ros, TCHAR_TO_UTF8(*Topic), TCHAR_TO_UTF8(*MessageType), QueueSize);
-	}
-
-	void MessageCallback(const ROSBridgePublishMsg &message)
-	{
-		TSharedPtr<FROSBaseMsg> BaseMsg;
-		if (ConvertMessage(&message, BaseMsg)) {
-			_Callback(BaseMsg);
-		}
-		else {
-			UE_LOG(LogROS, Error, TEXT("Couldn't convert incoming Message; Skipping callback"));
-		}
+		_ROSTopic = new rosbridge2cpp::ROSTopic(Ric->_Implementation->Get()->_Ros, TCHAR_TO_UTF8(*Topic), TCHAR_TO_UTF8(*MessageType), QueueSize,
+			static_cast<rosbridge2cpp::PublisherPriority>(Priority));
+		_ROSTopic->SetLatch(bLatch);
 	}
 };
 
@@ -204,10 +218,16 @@ void UTopic::BeginDestroy() {
 	_SelfPtr.Reset();
 }
 
-bool UTopic::Subscribe(std::function<void(TSharedPtr<FROSBaseMsg>)> func)
+bool UTopic::Subscribe(std::function<void(TSharedPtr<FROSBaseMsg>)> func, ETopicQueuePolicy QueuePolicy)
+{
+	_State.Subscribed = true;
+	return _State.Connected && _Implementation->Subscribe(func, nullptr, QueuePolicy);
+}
+
+bool UTopic::SubscribeEncoded(std::function<void(const ROSBridgePublishMsg&)> func, ETopicQueuePolicy QueuePolicy)
 {
 	_State.Subscribed = true;
-	return _State.Connected && _Implementation->Subscribe(func);
+	return _State.Connected && _Implementation->Subscribe(nullptr, func, QueuePolicy);
 }
 
 bool UTopic::Unsubscribe()
@@ -233,10 +253,20 @@ bool UTopic::Publish(TSharedPtr<FROSBaseMsg> msg)
 	return _State.Connected && _Implementation->Publish(msg);
 }
 
-void UTopic::Init(UROSIntegrationCore *Ric, FString Topic, FString MessageType, int32 QueueSize)
+bool UTopic::PublishEncoded(TFunctionRef<bool(bson_t*)> AppendFields, TFunctionRef<bool(FBSONTemplateWriter&)> WriteValues)
+{
+	return _State.Connected && _Implementation->PublishEncoded(AppendFields, WriteValues);
+}
+
+bool UTopic::PublishEncoded(TFunctionRef<bool(bson_t*)> AppendFields)
+{
+	return _State.Connected && _Implementation->PublishEncoded(AppendFields);
+}
+
+void UTopic::Init(UROSIntegrationCore *Ric, FString Topic, FString MessageType, int32 QueueSize, ETopicPriority Priority, bool bLatch)
 {
 	_ROSIntegrationCore = Ric;
-	_Implementation->Init(Ric, Topic, MessageType, QueueSize);
+	_Implementation->Init(Ric, Topic, MessageType, QueueSize, Priority, bLatch);
 }
 
 void UTopic::MarkAsDisconnected()
@@ -251,12 +281,12 @@ bool UTopic::Reconnect(UROSIntegrationCore* ROSIntegrationCore)
 
 	Impl* oldImplementation = _Implementation;
 	_Implementation = new UTopic::Impl();
-	_Implementation->Init(ROSIntegrationCore, oldImplementation->_Topic, oldImplementation->_MessageType, oldImplementation->_QueueSize);
+	_Implementation->Init(ROSIntegrationCore, oldImplementation->_Topic, oldImplementation->_MessageType, oldImplementation->_QueueSize, oldImplementation->_Priority, oldImplementation->_bLatch);
 
 	_State.Connected = true;
 	if (_State.Subscribed)
 	{
-		success = Subscribe(oldImplementation->_Callback);
+		success = _Implementation->Subscribe(oldImplementation->_Callback, oldImplementation->_EncodedCallback, oldImplementation->_QueuePolicy);
 	}
 	if (_State.Advertised)
 	{
@@ -282,7 +312,7 @@ FString UTopic::GetDetailedInfoInternal() const
 	return _Implementation->_Topic;
 }
 
-void UTopic::Init(const FString& TopicName, EMessageType MessageType, int32 QueueSize)
+void UTopic::Init(const FString& TopicName, EMessageType MessageType, int32 QueueSize, ETopicPriority Priority)
 {
 	_State.Blueprint = true;
 	_State.BlueprintMessageType = MessageType;
@@ -292,7 +322,7 @@ void UTopic::Init(const FString& TopicName, EMessageType MessageType, int32 Queu
 	{
 		if (ROSInstance->bConnectToROS && _State.Connected)
 		{
-			Init(ROSInstance->ROSIntegrationCore, TopicName, SupportedMessageTypes[MessageType], QueueSize);
+			Init(ROSInstance->ROSIntegrationCore, TopicName, SupportedMessageTypes[MessageType], QueueSize, Priority);
 		}
 	}
 	else
@@ -108,14 +108,28 @@ uint16_t TCPConnection::Fletcher16( const uint8_t *data, int count )
 	return (sum2 << 8) | sum1;
 }
 
+// Size of the receive buffer in BSON mode. It only grows if a single message doesn't fit.
+static const int32 ReceiveBufferSize = 10 * 1024 * 1024;
+
+// Reads the length prefix of a BSON document
+static int32_t ReadBSONLength(const uint8 *data)
+{
+#if PLATFORM_LITTLE_ENDIAN
+	return (data[3] << 24 | data[2] << 16 | data[1] << 8 | data[0]);
+#else
+	return *((int32_t*)data);
+#endif
+}
+
 int TCPConnection::ReceiverThreadFunction()
 {
+	// In BSON mode, the socket is read into this buffer as far as it fits.
+	// All complete messages are handed to the callback directly from the buffer,
+	// the incomplete rest is moved to the front before the next read.
 	TArray<uint8> binary_buffer;
-	uint32_t buffer_size = 10 * 1024 * 1024;
-	binary_buffer.Reserve(buffer_size);
-	bool bson_state_read_length = true; // indicate that the receiver shall only get 4 bytes to start with
-	int32_t bson_msg_length = 0;
-	int32_t bson_msg_length_read = 0;
+	binary_buffer.SetNumUninitialized(ReceiveBufferSize);
+	int32 read_position = 0; // start of the first unprocessed message
+	int32 write_position = 0; // end of the received data
 	int return_value = 0;
 
 	while (run_receiver_thread) {
@@ -140,56 +154,60 @@ int TCPConnection::ReceiverThreadFunction()
 		}
 
 		if (bson_only_mode_) {
-			if (bson_state_read_length) {
-				bson_msg_length_read = 0;
-				binary_buffer.SetNumUninitialized(4, false);
-				int32 bytes_read = 0;
-				if (_sock->Recv(binary_buffer.GetData(), 4, bytes_read) && bytes_read > 0) {
-					bson_msg_length_read += bytes_read;
-					if (bytes_read == 4) {
-#if PLATFORM_LITTLE_ENDIAN
-						bson_msg_length = (
-							binary_buffer.GetData()[3] << 24 |
-							binary_buffer.GetData()[2] << 16 |
-							binary_buffer.GetData()[1] << 8 |
-							binary_buffer.GetData()[0]
-						);
-#else
-						bson_msg_length = *((uint32_t*)&binary_buffer[0]);
-#endif
-						// Indicate the message retrieval mode
-						bson_state_read_length = false;
-						binary_buffer.SetNumUninitialized(bson_msg_length, false);
-					} else {
-						UE_LOG(LogROS, Error, TEXT("bytes_read is not 4 in bson_state_read_length==true. It's: %d"), bytes_read);
-					}
-				} else {
-					UE_LOG(LogROS, Error, TEXT("Failed to recv(); Closing receiver thread."));
+			if (write_position == binary_buffer.Num()) {
+				// make space for the rest of the incomplete message at the end of the buffer
+				const int32 pending = write_position - read_position;
+				if (read_position > 0) {
+					FMemory::Memmove(binary_buffer.GetData(), binary_buffer.GetData() + read_position, pending);
+					read_position = 0;
+					write_position = pending;
+				}
+				else {
+					// the message alone is larger than the buffer
+					const int32 message_length = ReadBSONLength(binary_buffer.GetData());
+					binary_buffer.SetNumUninitialized(FMath::Max(message_length, 2 * binary_buffer.Num()), false);
+					UE_LOG(LogROS, Verbose, TEXT("Receive buffer grown to %d bytes"), binary_buffer.Num());
+				}
+			}
+
+			int32 bytes_read = 0;
+			if (!_sock->Recv(binary_buffer.GetData() + write_position, binary_buffer.Num() - write_position, bytes_read) || bytes_read <= 0) {
+				UE_LOG(LogROS, Error, TEXT("Failed to recv(); Closing receiver thread."));
+				run_receiver_thread = false;
+				continue;
+			}
+			write_position += bytes_read;
+
+			// process all complete messages in the buffer
+			while (write_position - read_position >= 4) {
+				const int32_t bson_msg_length = ReadBSONLength(binary_buffer.GetData() + read_position);
+				if (bson_msg_length < 5) {
+					UE_LOG(LogROS, Error, TEXT("Received invalid BSON message length %d; Closing receiver thread."), bson_msg_length);
+					ReportError(rosbridge2cpp::TransportError::R2C_SOCKET_ERROR);
 					run_receiver_thread = false;
+					return_value = 2;
+					break;
 				}
-			} else {
-				// Message retrieval mode
-				int32 bytes_read = 0;
-				if (_sock->Recv(binary_buffer.GetData() + bson_msg_length_read, bson_msg_length - bson_msg_length_read, bytes_read) && bytes_read > 0) {
-
-					bson_msg_length_read += bytes_read;
-					if (bson_msg_length_read == bson_msg_length) {
-						// Full received message!
-						bson_state_read_length = true;
-						bson_t b;
-						if (!bson_init_static(&b, binary_buffer.GetData(), bson_msg_length_read)) {
-							UE_LOG(LogROS, Error, TEXT("Error on BSON parse - Ignoring message"));
-							continue;
-						}
-						if (incoming_message_callback_bson_) {
-							incoming_message_callback_bson_(b);
-						}
-					} else {
-						UE_LOG(LogROS, VeryVerbose, TEXT("Binary buffer num is: %d"), binary_buffer.Num());
+				if (write_position - read_position < bson_msg_length) {
+					break;
+				}
+
+				bson_t b;
+				if (!bson_init_static(&b, binary_buffer.GetData() + read_position, bson_msg_length)) {
+					UE_LOG(LogROS, Error, TEXT("Error on BSON parse - Ignoring message"));
+				}
+				else {
+					std::lock_guard<std::mutex> lock(incoming_message_callback_mutex_);
+					if (incoming_message_callback_bson_) {
+						incoming_message_callback_bson_(b);
 					}
-				} else {
-					UE_LOG(LogROS, Error, TEXT("Failed to recv()"));
 				}
+				read_position += bson_msg_length;
+			}
+
+			if (read_position == write_position) {
+				read_position = 0;
+				write_position = 0;
 			}
 		}
 		else {
@@ -226,6 +244,7 @@ int TCPConnection::ReceiverThreadFunction()
 			json j;
 			j.Parse(TCHAR_TO_UTF8(*result));
 
+			std::lock_guard<std::mutex> lock(incoming_message_callback_mutex_);
 			if (_incoming_message_callback)
 				_incoming_message_callback(j);
 		}
@@ -237,16 +256,27 @@ int TCPConnection::ReceiverThreadFunction()
 
 void TCPConnection::RegisterIncomingMessageCallback(std::function<void(json&)> fun)
 {
+	std::lock_guard<std::mutex> lock(incoming_message_callback_mutex_);
 	_incoming_message_callback = fun;
 	_callback_function_defined = true;
 }
 
 void TCPConnection::RegisterIncomingMessageCallback(std::function<void(bson_t&)> fun)
 {
+	std::lock_guard<std::mutex> lock(incoming_message_callback_mutex_);
 	incoming_message_callback_bson_ = fun;
 	_callback_function_defined = true;
 }
 
+void TCPConnection::UnregisterIncomingMessageCallbacks()
+{
+	// waits for the message that is currently being handed over
+	std::lock_guard<std::mutex> lock(incoming_message_callback_mutex_);
+	_incoming_message_callback = nullptr;
+	incoming_message_callback_bson_ = nullptr;
+	_callback_function_defined = false;
+}
+
 void TCPConnection::RegisterErrorCallback(std::function<void(rosbridge2cpp::TransportError)> fun)
 {
 	_error_callback = fun;
@@ -7,6 +7,7 @@
 #include <thread>
 
 #include <functional> // std::function
+#include <mutex>
 
 // #include "json.hpp"
 #include <CoreMinimal.h>
@@ -50,6 +51,7 @@ public:
 	int ReceiverThreadFunction();
 	void RegisterIncomingMessageCallback(std::function<void(json&)> fun);
 	void RegisterIncomingMessageCallback(std::function<void(bson_t&)> fun);
+	void UnregisterIncomingMessageCallbacks();
 	void RegisterErrorCallback(std::function<void(rosbridge2cpp::TransportError)> fun);
 	void ReportError(rosbridge2cpp::TransportError err);
 	void SetTransportMode(rosbridge2cpp::ITransportLayer::TransportMode);
@@ -68,6 +70,7 @@ private:
 	bool receiverThreadSetUp = false;
 	bool _callback_function_defined = false;
 	bool bson_only_mode_ = false;
+	std::mutex incoming_message_callback_mutex_; // held while the incoming message callbacks run
 	std::function<void(json&)> _incoming_message_callback;
 	std::function<void(bson_t&)> incoming_message_callback_bson_;
 	std::function<void(rosbridge2cpp::TransportError)> _error_callback;
@@ -4,6 +4,7 @@
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
 #include <bson.h>
+#include <iostream>
 
 using json = rapidjson::Document;
 namespace rosbridge2cpp {
@@ -0,0 +1,138 @@
+#include "incoming_message_dispatcher.h"
+
+#include <algorithm>
+
+namespace rosbridge2cpp {
+
+	IncomingMessageDispatcher::IncomingMessageDispatcher()
+	{
+	}
+
+	IncomingMessageDispatcher::~IncomingMessageDispatcher()
+	{
+		Stop();
+	}
+
+	void IncomingMessageDispatcher::Start(unsigned int num_workers, FunVrBSONrEnvelope handler, size_t max_queue_depth)
+	{
+		if (!workers_.empty())
+			return;
+
+		if (num_workers == 0) {
+			// leave cores for the game and render threads
+			num_workers = std::min(4u, std::max(1u, std::thread::hardware_concurrency() / 2));
+		}
+
+		handler_ = handler;
+		max_queue_depth_ = std::max<size_t>(1, max_queue_depth);
+		run_workers_ = true;
+		for (unsigned int i = 0; i < num_workers; ++i) {
+			workers_.emplace_back(new Worker());
+		}
+		for (auto &worker : workers_) {
+			Worker *w = worker.get();
+			w->thread = std::thread([this, w] { RunWorker(*w); });
+		}
+	}
+
+	void IncomingMessageDispatcher::Stop()
+	{
+		// Dispatch checks the flag under the lock of its worker, so it doesn't queue anything after this
+		for (auto &worker : workers_) {
+			worker->mutex.lock();
+		}
+		run_workers_ = false;
+		for (auto &worker : workers_) {
+			worker->mutex.unlock();
+			worker->message_queued.notify_all();
+			worker->message_taken.notify_all();
+		}
+
+		for (auto &worker : workers_) {
+			if (worker->thread.joinable()) {
+				worker->thread.join();
+			}
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			for (QueuedMessage &queued : worker->messages) {
+				bson_destroy(queued.message);
+			}
+			worker->messages.clear();
+			worker->queue_depth = 0;
+		}
+	}
+
+	bool IncomingMessageDispatcher::Dispatch(const std::string &key, const bson_t &message, const ROSBridgeEnvelope &envelope)
+	{
+		if (!run_workers_)
+			return false;
+
+		// the receive buffer is reused for the next messages
+		QueuedMessage queued = { bson_copy(&message), envelope };
+		queued.envelope.Rebase(message, *queued.message);
+
+		Worker &worker = *workers_[std::hash<std::string>()(key) % workers_.size()];
+		size_t depth;
+		{
+			std::unique_lock<std::mutex> lock(worker.mutex);
+			if (worker.messages.size() >= max_queue_depth_) {
+				// leaves the next messages in the socket until the worker has caught up
+				++num_blocked_dispatches_;
+				worker.message_taken.wait(lock, [this, &worker] { return worker.messages.size() < max_queue_depth_ || !run_workers_; });
+			}
+			if (!run_workers_) {
+				lock.unlock();
+				bson_destroy(queued.message);
+				return false;
+			}
+			worker.messages.push_back(queued);
+			depth = ++worker.queue_depth;
+		}
+		worker.message_queued.notify_one();
+
+		++num_dispatched_messages_;
+		size_t peak = peak_queue_depth_;
+		while (depth > peak && !peak_queue_depth_.compare_exchange_weak(peak, depth)) {}
+		return true;
+	}
+
+	size_t IncomingMessageDispatcher::QueueDepth(unsigned int worker) const
+	{
+		return worker < workers_.size() ? workers_[worker]->queue_depth.load() : 0;
+	}
+
+	size_t IncomingMessageDispatcher::TotalQueueDepth() const
+	{
+		size_t depth = 0;
+		for (auto &worker : workers_) {
+			depth += worker->queue_depth;
+		}
+		return depth;
+	}
+
+	void IncomingMessageDispatcher::RunWorker(Worker &worker)
+	{
+		while (true) {
+			QueuedMessage queued;
+			{
+				std::unique_lock<std::mutex> lock(worker.mutex);
+				worker.message_queued.wait(lock, [this, &worker] { return !worker.messages.empty() || !run_workers_; });
+				if (!run_workers_)
+					return;
+				queued = worker.messages.front();
+				worker.messages.pop_front();
+			}
+			worker.message_taken.notify_one();
+
+			// handlers may keep pointers into the message and destroy it like a received one, so hand over a static view.
+			// The view shares the data of the copy, so the envelope still points into it.
+			bson_t view;
+			if (bson_init_static(&view, bson_get_data(queued.message), queued.message->len)) {
+				handler_(view, queued.envelope);
+			}
+			bson_destroy(queued.message);
+
+			--worker.queue_depth;
+			++num_handled_messages_;
+		}
+	}
+}
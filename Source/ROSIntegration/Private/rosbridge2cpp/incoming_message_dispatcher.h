@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <bson.h>
+
+#include "messages/rosbridge_msg.h"
+
+namespace rosbridge2cpp {
+
+	// Runs the handling of incoming messages on a pool of worker threads,
+	// so that a slow callback doesn't hold up the socket or the callbacks of other topics.
+	//
+	// Every message is dispatched with a key (e.g. its topic) and its decoded envelope, which the handler gets along with it.
+	// Messages with the same key always go to the same worker and are handled in the order they were received.
+	// The queue of every worker is bounded. When it is full, Dispatch blocks the receiving thread,
+	// so a slow handler fills the socket buffer instead of the heap.
+	class IncomingMessageDispatcher {
+	public:
+		typedef std::function<void(bson_t&, const ROSBridgeEnvelope&)> FunVrBSONrEnvelope;
+
+		static const size_t DefaultMaxQueueDepth = 64;
+
+		IncomingMessageDispatcher();
+		~IncomingMessageDispatcher();
+
+		// Starts num_workers threads that pass the dispatched messages to handler.
+		// num_workers == 0 selects a default based on the number of cores.
+		// Every worker queues up to max_queue_depth messages.
+		// Can only be called once, before any message is dispatched.
+		void Start(unsigned int num_workers, FunVrBSONrEnvelope handler, size_t max_queue_depth = DefaultMaxQueueDepth);
+
+		// Stops all workers after their current message and waits for them. Messages that are still queued are dropped.
+		// Dispatch may still be called afterwards, it returns false.
+		void Stop();
+
+		bool IsRunning() const { return run_workers_; }
+
+		// Copies message and queues it for the worker that is responsible for key.
+		// envelope must have been decoded from message, the handler gets it rebased onto the copy.
+		// Blocks while the queue of the worker is full.
+		// Returns false if the dispatcher is not running.
+		bool Dispatch(const std::string &key, const bson_t &message, const ROSBridgeEnvelope &envelope);
+
+		// Queue depth counters
+		unsigned int NumWorkers() const { return (unsigned int)workers_.size(); }
+		size_t QueueDepth(unsigned int worker) const;
+		size_t TotalQueueDepth() const;
+		size_t PeakQueueDepth() const { return peak_queue_depth_; }
+		size_t MaxQueueDepth() const { return max_queue_depth_; }
+		uint64_t NumBlockedDispatches() const { return num_blocked_dispatches_; }
+		uint64_t NumDispatchedMessages() const { return num_dispatched_messages_; }
+		uint64_t NumHandledMessages() const { return num_handled_messages_; }
+
+	private:
+		struct QueuedMessage {
+			bson_t *message;
+			ROSBridgeEnvelope envelope; // points into message
+		};
+
+		struct Worker {
+			std::thread thread;
+			std::mutex mutex; // guards messages
+			std::condition_variable message_queued;
+			std::condition_variable message_taken;
+			std::deque<QueuedMessage> messages;
+			std::atomic<size_t> queue_depth{ 0 };
+		};
+
+		void RunWorker(Worker &worker);
+
+		// not changed while the workers are running, so Dispatch can select a worker without a lock
+		std::vector<std::unique_ptr<Worker>> workers_;
+		FunVrBSONrEnvelope handler_;
+		size_t max_queue_depth_ = DefaultMaxQueueDepth;
+		std::atomic<bool> run_workers_{ false }; // only set to false while holding the mutex of every worker
+
+		std::atomic<size_t> peak_queue_depth_{ 0 };
+		std::atomic<uint64_t> num_dispatched_messages_{ 0 };
+		std::atomic<uint64_t> num_handled_messages_{ 0 };
+		std::atomic<uint64_t> num_blocked_dispatches_{ 0 };
+
+		IncomingMessageDispatcher(IncomingMessageDispatcher const &);
+		IncomingMessageDispatcher & operator=(IncomingMessageDispatcher const &);
+	};
+}
@@ -33,6 +33,10 @@ namespace rosbridge2cpp {
 		// Register a std::function that will be called whenever a new data packet has been received by this TransportLayer.
 		virtual void RegisterIncomingMessageCallback(std::function<void(bson_t&)>) = 0;
 
+		// Removes the registered incoming message callbacks.
+		// When this returns, none of them is running anymore and they won't be called again.
+		virtual void UnregisterIncomingMessageCallbacks() = 0;
+
 		// Register a std::function that will be called when errors occur.
 		virtual void RegisterErrorCallback(std::function<void(TransportError)>) = 0;
 
@@ -51,21 +51,26 @@ public:
 		return true;
 	}
 
-	bool FromBSON(bson_t &bson) {
-		if (!ROSBridgeMsg::FromBSON(bson))
+	bool FromBSON(bson_t &bson)
+	{
+		ROSBridgeEnvelope envelope;
+		envelope.Decode(bson);
+		return FromBSON(bson, envelope);
+	}
+
+	bool FromBSON(bson_t &bson, const ROSBridgeEnvelope &envelope)
+	{
+		if (!ROSBridgeMsg::FromBSON(bson, envelope))
 			return false;
 
-		if (!bson_has_field(&bson, "service")) {
+		if (!envelope.service) {
 			std::cerr << "[ROSBridgeCallServiceMsg] Received 'call_service' message without 'service' field." << std::endl;
 			return false;
 		}
 
-		bool key_found = false;
-		service_ = rosbridge2cpp::Helper::get_utf8_by_key("service", bson, key_found);
-		assert(key_found);
-		key_found = false;
+		service_.assign(envelope.service, envelope.service_length);
 
-		if (!bson_has_field(&bson, "args")) {
+		if (!envelope.args_offset) {
 			std::cerr << "[ROSBridgeCallServiceMsg] Received 'call_service' message without 'args' field." << std::endl;
 			return false;
 		}
@@ -90,7 +95,7 @@ public:
 
 	void ToBSON(bson_t &bson)
 	{
-		BSON_APPEND_UTF8(&bson, "op", getOpCodeString().c_str());
+		BSON_APPEND_UTF8(&bson, "op", getOpCodeName());
 		add_if_value_changed(bson, "id", id_);
 
 		add_if_value_changed(bson, "service", service_);
@@ -3,13 +3,15 @@
 #include "rapidjson/document.h"
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
-#include <unordered_map>
+#include <cstring>
 
 #include <bson.h>
 
 #include "helper.h"
 
 
+struct ROSBridgeEnvelope;
+
 /*
  * The base class for all ROSBridge messages
  *
@@ -37,40 +39,39 @@ public:
 		SERVICE_RESPONSE
 	};
 
-	std::unordered_map<std::string, OpCode> op_code_mapping = {
-		{"fragment", FRAGMENT},
-		{"png", PNG},
-		{"set_level", SET_LEVEL},
-		{"status", STATUS},
-		{"auth", AUTH},
-		{"advertise", ADVERTISE},
-		{"unadvertise", UNADVERTISE},
-		{"publish", PUBLISH},
-		{"subscribe", SUBSCRIBE},
-		{"unsubscribe", UNSUBSCRIBE},
-		{"advertise_service", ADVERTISE_SERVICE},
-		{"unadvertise_service", UNADVERTISE_SERVICE},
-		{"call_service", CALL_SERVICE},
-		{"service_response", SERVICE_RESPONSE}
-	};
+	// Wire names of the op codes, indexed by OpCode
+	static const char* const* OpCodeNames()
+	{
+		static const char* const names[] = {
+			"opcode_undefined",
+			"fragment",
+			"png",
+			"set_level",
+			"status",
+			"auth",
+			"advertise",
+			"unadvertise",
+			"publish",
+			"subscribe",
+			"unsubscribe",
+			"advertise_service",
+			"unadvertise_service",
+			"call_service",
+			"service_response"
+		};
+		return names;
+	}
 
-	// std::unordered_map<OpCode, std::string> reverse_op_code_mapping = {
-	//   {OPCODE_UNDEFINED,"opcode_undefined"},
-	//   {FRAGMENT,"fragment"},
-	//   {PNG,"png"},
-	//   {SET_LEVEL,"set_level"},
-	//   {STATUS, "status"},
-	//   {AUTH, "auth"},
-	//   {ADVERTISE, "advertise"},
-	//   {UNADVERTISE, "unadvertise"},
-	//   {PUBLISH, "publish"},
-	//   {SUBSCRIBE, "subscribe"},
-	//   {UNSUBSCRIBE, "unsubscribe"},
-	//   {ADVERTISE_SERVICE, "advertise_service"},
-	//   {UNADVERTISE_SERVICE, "unadvertise_service"},
-	//   {CALL_SERVICE, "call_service"},
-	//   {SERVICE_RESPONSE, "service_response"}
-	// };
+	// Returns OPCODE_UNDEFINED if op is not a valid op code
+	static OpCode OpCodeFromString(const char *op, size_t length)
+	{
+		const char* const* names = OpCodeNames();
+		for (int i = FRAGMENT; i <= SERVICE_RESPONSE; ++i) {
+			if (names[i][0] == op[0] && strncmp(names[i], op, length) == 0 && names[i][length] == '\0')
+				return static_cast<OpCode>(i);
+		}
+		return OPCODE_UNDEFINED;
+	}
 
 	ROSBridgeMsg() = default;
 
@@ -88,15 +89,12 @@ public:
 			return false;
 		}
 
-		std::string op_code = data["op"].GetString();
-		auto mapping_iterator = op_code_mapping.find(op_code);
-		if (mapping_iterator == op_code_mapping.end()) {
-			std::cerr << "[ROSBridgeMsg] Received message with invalid 'op' field: " << op_code << std::endl;
+		op_ = OpCodeFromString(data["op"].GetString(), data["op"].GetStringLength());
+		if (op_ == OPCODE_UNDEFINED) {
+			std::cerr << "[ROSBridgeMsg] Received message with invalid 'op' field: " << data["op"].GetString() << std::endl;
 			return false;
 		}
 
-		op_ = mapping_iterator->second;
-
 		if (!data.HasMember("id"))
 			return true; // return true, because id is only optional
 
@@ -105,53 +103,20 @@ public:
 		return true;
 	}
 
-	bool FromBSON(bson_t &bson)
-	{
-		if (!bson_has_field(&bson, "op")) {
-			std::cerr << "[ROSBridgeMsg] Received message without 'op' field" << std::endl;
-			return false;
-		}
-
-		bool key_found = false;
-		std::string op_code = rosbridge2cpp::Helper::get_utf8_by_key("op", bson, key_found);
-		assert(key_found); // should always be true, otherwise this is contradictory to the !bson_has_field check
-		key_found = false;
-
-		auto mapping_iterator = op_code_mapping.find(op_code);
-		if (mapping_iterator == op_code_mapping.end()) {
-			std::cerr << "[ROSBridgeMsg] Received message with invalid 'op' field: " << op_code << std::endl;
-			return false;
-		}
+	bool FromBSON(bson_t &bson);
 
-		op_ = mapping_iterator->second;
+	// Takes the 'op' and 'id' fields from an already decoded message
+	bool FromBSON(bson_t &bson, const ROSBridgeEnvelope &envelope);
 
-		if (!bson_has_field(&bson, "id"))
-			return true; // return true, because id is only optional
-
-		id_ = rosbridge2cpp::Helper::get_utf8_by_key("id", bson, key_found);
-		assert(key_found);
-
-		return true;
+	std::string getOpCodeString()
+	{
+		return getOpCodeName();
 	}
 
-	std::string getOpCodeString()
+	const char* getOpCodeName() const
 	{
-		if (op_ == OPCODE_UNDEFINED) return "opcode_undefined";
-		if (op_ == FRAGMENT) return "fragment";
-		if (op_ == PNG) return "png";
-		if (op_ == SET_LEVEL) return "set_level";
-		if (op_ == STATUS) return  "status";
-		if (op_ == AUTH) return  "auth";
-		if (op_ == ADVERTISE) return  "advertise";
-		if (op_ == UNADVERTISE) return  "unadvertise";
-		if (op_ == PUBLISH) return  "publish";
-		if (op_ == SUBSCRIBE) return  "subscribe";
-		if (op_ == UNSUBSCRIBE) return  "unsubscribe";
-		if (op_ == ADVERTISE_SERVICE) return  "advertise_service";
-		if (op_ == UNADVERTISE_SERVICE) return  "unadvertise_service";
-		if (op_ == CALL_SERVICE) return  "call_service";
-		if (op_ == SERVICE_RESPONSE) return  "service_response";
-		return "";
+		if (op_ < OPCODE_UNDEFINED || op_ > SERVICE_RESPONSE) return "";
+		return OpCodeNames()[op_];
 	}
 
 	virtual ~ROSBridgeMsg() = default;
@@ -193,3 +158,121 @@ protected:
 private:
 	/* data */
 };
+
+/*
+ * The fields of an incoming ROSBridge message that are needed to dispatch it,
+ * decoded in a single pass over the message.
+ *
+ * Strings point into the decoded bson and are only valid as long as it lives.
+ * Subdocuments are given by the offset of their element in the message, or 0 if they are missing.
+ * An envelope can be passed on with a copy of the message after Rebase, so the copy isn't decoded again.
+ */
+struct ROSBridgeEnvelope {
+	ROSBridgeMsg::OpCode op = ROSBridgeMsg::OPCODE_UNDEFINED;
+	const char *op_string = nullptr;
+	const char *id = nullptr;
+	uint32_t id_length = 0;
+	const char *topic = nullptr;
+	uint32_t topic_length = 0;
+	const char *service = nullptr;
+	uint32_t service_length = 0;
+	bool has_result = false;
+	bool result = false;
+	uint32_t msg_offset = 0;
+	uint32_t values_offset = 0;
+	uint32_t args_offset = 0;
+
+	// Returns false if the message has no 'op' field
+	bool Decode(const bson_t &bson)
+	{
+		bson_iter_t iter;
+		if (!bson_iter_init(&iter, &bson))
+			return false;
+
+		while (bson_iter_next(&iter)) {
+			const char *key = bson_iter_key(&iter);
+			switch (key[0]) {
+			case 'o':
+				if (strcmp(key, "op") == 0 && BSON_ITER_HOLDS_UTF8(&iter)) {
+					uint32_t length;
+					op_string = bson_iter_utf8(&iter, &length);
+					op = ROSBridgeMsg::OpCodeFromString(op_string, length);
+				}
+				break;
+			case 'i':
+				if (strcmp(key, "id") == 0 && BSON_ITER_HOLDS_UTF8(&iter))
+					id = bson_iter_utf8(&iter, &id_length);
+				break;
+			case 't':
+				if (strcmp(key, "topic") == 0 && BSON_ITER_HOLDS_UTF8(&iter))
+					topic = bson_iter_utf8(&iter, &topic_length);
+				break;
+			case 's':
+				if (strcmp(key, "service") == 0 && BSON_ITER_HOLDS_UTF8(&iter))
+					service = bson_iter_utf8(&iter, &service_length);
+				break;
+			case 'r':
+				if (strcmp(key, "result") == 0 && BSON_ITER_HOLDS_BOOL(&iter)) {
+					has_result = true;
+					result = bson_iter_bool(&iter);
+				}
+				break;
+			case 'm':
+				if (strcmp(key, "msg") == 0)
+					msg_offset = iter.off;
+				break;
+			case 'v':
+				if (strcmp(key, "values") == 0)
+					values_offset = iter.off;
+				break;
+			case 'a':
+				if (strcmp(key, "args") == 0)
+					args_offset = iter.off;
+				break;
+			}
+		}
+		return op_string != nullptr;
+	}
+
+	// Points the strings into copy, which must hold the same bytes as decoded
+	void Rebase(const bson_t &decoded, const bson_t &copy)
+	{
+		const char *from = reinterpret_cast<const char*>(bson_get_data(&decoded));
+		const char *to = reinterpret_cast<const char*>(bson_get_data(&copy));
+		auto rebase = [from, to](const char *&str) {
+			if (str)
+				str = to + (str - from);
+		};
+		rebase(op_string);
+		rebase(id);
+		rebase(topic);
+		rebase(service);
+	}
+};
+
+inline bool ROSBridgeMsg::FromBSON(bson_t &bson)
+{
+	ROSBridgeEnvelope envelope;
+	envelope.Decode(bson);
+	return FromBSON(bson, envelope);
+}
+
+inline bool ROSBridgeMsg::FromBSON(bson_t &/*bson*/, const ROSBridgeEnvelope &envelope)
+{
+	if (!envelope.op_string) {
+		std::cerr << "[ROSBridgeMsg] Received message without 'op' field" << std::endl;
+		return false;
+	}
+
+	if (envelope.op == OPCODE_UNDEFINED) {
+		std::cerr << "[ROSBridgeMsg] Received message with invalid 'op' field: " << envelope.op_string << std::endl;
+		return false;
+	}
+
+	op_ = envelope.op;
+
+	if (envelope.id) // 'id' is only optional
+		id_.assign(envelope.id, envelope.id_length);
+
+	return true;
+}
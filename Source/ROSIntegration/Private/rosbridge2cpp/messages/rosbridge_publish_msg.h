@@ -51,25 +51,30 @@ public:
 
 	bool FromBSON(bson_t &bson)
 	{
-		if (!ROSBridgeMsg::FromBSON(bson))
+		ROSBridgeEnvelope envelope;
+		envelope.Decode(bson);
+		return FromBSON(bson, envelope);
+	}
+
+	bool FromBSON(bson_t &bson, const ROSBridgeEnvelope &envelope)
+	{
+		if (!ROSBridgeMsg::FromBSON(bson, envelope))
 			return false;
 
-		if (!bson_has_field(&bson, "topic")) {
+		if (!envelope.topic) {
 			std::cerr << "[ROSBridgePublishMsg] Received 'publish' message without 'topic' field." << std::endl;
 			return false;
 		}
 
-		bool key_found = false;
-		topic_ = rosbridge2cpp::Helper::get_utf8_by_key("topic", bson, key_found);
-		assert(key_found);
-		key_found = false;
+		topic_.assign(envelope.topic, envelope.topic_length);
 
-		if (!bson_has_field(&bson, "msg")) {
+		if (!envelope.msg_offset) {
 			std::cerr << "[ROSBridgePublishMsg] Received 'publish' message without 'msg' field." << std::endl;
 			return false;
 		}
 
 		full_msg_bson_ = &bson;
+		envelope_ = envelope;
 
 		return true;
 	}
@@ -94,18 +99,22 @@ public:
 
 	void ToBSON(bson_t &bson)
 	{
-		BSON_APPEND_UTF8(&bson, "op", getOpCodeString().c_str());
-		add_if_value_changed(bson, "id", id_);
-
-		add_if_value_changed(bson, "topic", topic_);
-		add_if_value_changed(bson, "type", type_);
-
-		BSON_APPEND_BOOL(&bson, "latch", latch_);
+		AppendEnvelopeToBSON(bson);
 		if (msg_bson_ != nullptr && !BSON_APPEND_DOCUMENT(&bson, "msg", msg_bson_)) {
 			std::cerr << "Error while appending 'msg' bson to messge BSON" << std::endl;
 		}
 	}
 
+	// Appends all fields of this message to bson and starts the 'msg' subdocument,
+	// so that the message content can be written directly into the outgoing message
+	// instead of being built separately and copied over.
+	// msg_bson_ is ignored. Finish with bson_append_document_end(&bson, &msg).
+	bool BeginBSON(bson_t &bson, bson_t &msg)
+	{
+		AppendEnvelopeToBSON(bson);
+		return BSON_APPEND_DOCUMENT_BEGIN(&bson, "msg", &msg);
+	}
+
 	std::string topic_;
 	std::string type_;
 	// std::string compression_;
@@ -129,6 +138,18 @@ public:
 	// might get modified.
 	bson_t *full_msg_bson_ = nullptr;
 
+	// The envelope that full_msg_bson_ has been decoded with, its strings point into full_msg_bson_
+	ROSBridgeEnvelope envelope_;
+
 private:
-	/* data */
+	void AppendEnvelopeToBSON(bson_t &bson)
+	{
+		BSON_APPEND_UTF8(&bson, "op", getOpCodeName());
+		add_if_value_changed(bson, "id", id_);
+
+		add_if_value_changed(bson, "topic", topic_);
+		add_if_value_changed(bson, "type", type_);
+
+		BSON_APPEND_BOOL(&bson, "latch", latch_);
+	}
 };
@@ -58,29 +58,31 @@ public:
 
 	bool FromBSON(bson_t &bson)
 	{
-		if (!ROSBridgeMsg::FromBSON(bson))
+		ROSBridgeEnvelope envelope;
+		envelope.Decode(bson);
+		return FromBSON(bson, envelope);
+	}
+
+	bool FromBSON(bson_t &bson, const ROSBridgeEnvelope &envelope)
+	{
+		if (!ROSBridgeMsg::FromBSON(bson, envelope))
 			return false;
 
-		if (!bson_has_field(&bson, "service")) {
+		if (!envelope.service) {
 			std::cerr << "[ROSBridgeServiceResponseMsg] Received 'service_response' message without 'service' field." << std::endl;
 			return false;
 		}
 
-		bool key_found = false;
-		service_ = rosbridge2cpp::Helper::get_utf8_by_key("service", bson, key_found);
-		assert(key_found);
-		key_found = false;
+		service_.assign(envelope.service, envelope.service_length);
 
-		if (!bson_has_field(&bson, "result")) {
+		if (!envelope.has_result) {
 			std::cerr << "[ROSBridgeServiceResponseMsg] Received 'service_response' message without 'result' field." << std::endl;
 			return false;
 		}
 
-		result_ = rosbridge2cpp::Helper::get_bool_by_key("result", bson, key_found);
-		assert(key_found);
-		key_found = false;
+		result_ = envelope.result;
 
-		if (!bson_has_field(&bson, "values")) {
+		if (!envelope.values_offset) {
 			return true;
 		}
 
@@ -105,7 +107,7 @@ public:
 
 	void ToBSON(bson_t &bson)
 	{
-		BSON_APPEND_UTF8(&bson, "op", getOpCodeString().c_str());
+		BSON_APPEND_UTF8(&bson, "op", getOpCodeName());
 		add_if_value_changed(bson, "id", id_);
 
 		add_if_value_changed(bson, "service", service_);
@@ -33,7 +33,7 @@ public:
 
 	void ToBSON(bson_t &bson)
 	{
-		BSON_APPEND_UTF8(&bson, "op", getOpCodeString().c_str());
+		BSON_APPEND_UTF8(&bson, "op", getOpCodeName());
 		add_if_value_changed(bson, "id", id_);
 
 		add_if_value_changed(bson, "service", service_);
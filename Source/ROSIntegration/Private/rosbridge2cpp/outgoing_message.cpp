@@ -0,0 +1,103 @@
+#include "outgoing_message.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace rosbridge2cpp {
+
+	// Message whose content is currently appended on this thread (see OutgoingMessage::Begin)
+	static thread_local OutgoingMessage *building_message = nullptr;
+
+	OutgoingMessage::OutgoingMessage(bson_t *bson)
+	: bson_(bson)
+	{
+		assert(bson_);
+	}
+
+	OutgoingMessage::~OutgoingMessage()
+	{
+		if (building_message == this)
+			building_message = nullptr;
+		bson_destroy(bson_);
+	}
+
+	void OutgoingMessage::Begin(bson_t &document)
+	{
+		assert(building_message == nullptr);
+
+		// the subdocument shares the buffer of the full message
+		document_ = &document;
+		document_offset_ = bson_get_data(&document) - bson_get_data(bson_);
+		building_message = this;
+	}
+
+	void OutgoingMessage::End()
+	{
+		document_ = nullptr;
+		if (building_message == this)
+			building_message = nullptr;
+	}
+
+	bool OutgoingMessage::AppendBinary(bson_t *document, const char *key, const uint8_t *data, uint32_t length, std::shared_ptr<const void> owner)
+	{
+		OutgoingMessage *message = building_message;
+		if (!message || message->document_ != document || length == 0) {
+			return bson_append_binary(document, key, -1, BSON_SUBTYPE_BINARY, data, length);
+		}
+
+		// append an empty binary field, its length is corrected when the message is sent
+		static const uint8_t empty = 0;
+		if (!bson_append_binary(document, key, -1, BSON_SUBTYPE_BINARY, &empty, 0))
+			return false;
+
+		// the data would start where the document now ends
+		const size_t offset = bson_get_data(document) + document->len - 1 - bson_get_data(message->bson_);
+		message->external_binaries_.push_back({ offset, data, length, std::move(owner) });
+		return true;
+	}
+
+	size_t OutgoingMessage::Size() const
+	{
+		size_t size = bson_->len;
+		for (auto& binary : external_binaries_) {
+			size += binary.length;
+		}
+		return size;
+	}
+
+	void OutgoingMessage::PatchLength(size_t offset, uint32_t length)
+	{
+		uint8_t *prefix = const_cast<uint8_t*>(bson_get_data(bson_)) + offset;
+		uint32_t value;
+		memcpy(&value, prefix, sizeof(value));
+		value = BSON_UINT32_TO_LE(BSON_UINT32_FROM_LE(value) + length);
+		memcpy(prefix, &value, sizeof(value));
+	}
+
+	bool OutgoingMessage::Send(ITransportLayer &transport_layer)
+	{
+		if (!lengths_patched_ && !external_binaries_.empty()) {
+			// Binary fields are encoded as int32 length, subtype byte, data.
+			// The full message and the 'msg' subdocument grow by the data that is sent separately.
+			uint32_t total_length = 0;
+			for (auto& binary : external_binaries_) {
+				PatchLength(binary.offset - 5, binary.length);
+				total_length += binary.length;
+			}
+			PatchLength(document_offset_, total_length);
+			PatchLength(0, total_length);
+			lengths_patched_ = true;
+		}
+
+		const uint8_t *bson_data = bson_get_data(bson_);
+		size_t position = 0;
+		for (auto& binary : external_binaries_) {
+			if (!transport_layer.SendMessage(bson_data + position, (unsigned int)(binary.offset - position)))
+				return false;
+			if (!transport_layer.SendMessage(binary.data, binary.length))
+				return false;
+			position = binary.offset;
+		}
+		return transport_layer.SendMessage(bson_data + position, (unsigned int)(bson_->len - position));
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <bson.h>
+
+#include "itransport_layer.h"
+
+namespace rosbridge2cpp {
+
+	// A serialized rosbridge message on its way to the publisher queue thread.
+	//
+	// Large binary fields can be attached without copying them into the bson document (see AppendBinary).
+	// The document then only contains an empty binary field at their position,
+	// and the data is written to the socket directly from the buffer of its owner,
+	// right after the bson bytes in front of it.
+	class OutgoingMessage {
+	public:
+		// Takes ownership of bson
+		explicit OutgoingMessage(bson_t *bson);
+		~OutgoingMessage();
+
+		// Marks document as the 'msg' subdocument of this message, while the message content is appended.
+		// Until End() is called, AppendBinary will attach binary fields of document to this message.
+		// Only one message per thread can be built this way at a time.
+		void Begin(bson_t &document);
+		void End();
+
+		// Appends a binary field to document.
+		// If document is the subdocument given to Begin(), data is not copied but sent from its buffer later on.
+		// owner has to keep data alive and unmodified until then, and is released
+		// as soon as the data has been written to the socket or the message has been dropped.
+		// Otherwise data is copied into document like with bson_append_binary.
+		static bool AppendBinary(bson_t *document, const char *key, const uint8_t *data, uint32_t length, std::shared_ptr<const void> owner);
+
+		// Size of the message on the wire
+		size_t Size() const;
+
+		// Writes the message to transport_layer, including all attached binary data.
+		// The caller has to own the transport layer for the duration of the call.
+		bool Send(ITransportLayer &transport_layer);
+
+	private:
+		struct ExternalBinary {
+			size_t offset; // position of the binary data in the serialized message
+			const uint8_t *data;
+			uint32_t length;
+			std::shared_ptr<const void> owner;
+		};
+
+		// Adds length to the int32 length prefix at offset in the bson buffer
+		void PatchLength(size_t offset, uint32_t length);
+
+		bson_t *bson_;
+		std::vector<ExternalBinary> external_binaries_;
+
+		// Offset of the 'msg' subdocument while it is being built
+		bson_t *document_ = nullptr;
+		size_t document_offset_ = 0;
+
+		// Length prefixes are patched before the first send
+		bool lengths_patched_ = false;
+
+		OutgoingMessage(OutgoingMessage const &);
+		OutgoingMessage & operator=(OutgoingMessage const &);
+	};
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace rosbridge2cpp {
+
+	// Bounded lock-free ring buffer (after Dmitry Vyukov's bounded MPMC queue).
+	//
+	// Any number of threads may push and pop concurrently without taking a lock.
+	// The publisher queues use it as a multi-producer/single-consumer queue,
+	// where producers only pop to drop the oldest element when the queue is full.
+	//
+	// The capacity is rounded up to the next power of two.
+	template<typename T>
+	class ring_buffer
+	{
+	private:
+		struct cell
+		{
+			std::atomic<size_t> sequence;
+			T data;
+		};
+
+		// keep producer and consumer positions on separate cache lines
+		static const size_t cache_line_size = 64;
+
+		std::unique_ptr<cell[]> buffer_;
+		size_t buffer_mask_;
+		alignas(cache_line_size) std::atomic<size_t> enqueue_pos_;
+		alignas(cache_line_size) std::atomic<size_t> dequeue_pos_;
+
+		ring_buffer(ring_buffer const &);
+		ring_buffer & operator=(ring_buffer const &);
+
+		static size_t round_up_to_power_of_two(size_t v)
+		{
+			size_t p = 2;
+			while (p < v)
+			{
+				p <<= 1;
+			}
+			return p;
+		}
+
+	public:
+		explicit ring_buffer(size_t capacity)
+		: buffer_(new cell[round_up_to_power_of_two(capacity)])
+		, buffer_mask_(round_up_to_power_of_two(capacity) - 1)
+		{
+			for (size_t i = 0; i <= buffer_mask_; ++i)
+			{
+				buffer_[i].sequence.store(i, std::memory_order_relaxed);
+			}
+			enqueue_pos_.store(0, std::memory_order_relaxed);
+			dequeue_pos_.store(0, std::memory_order_relaxed);
+		}
+
+		size_t capacity() const
+		{
+			return buffer_mask_ + 1;
+		}
+
+		// Number of elements in the buffer.
+		// Only a snapshot if other threads push or pop at the same time.
+		size_t size() const
+		{
+			const size_t dequeue_pos = dequeue_pos_.load(std::memory_order_relaxed);
+			const size_t enqueue_pos = enqueue_pos_.load(std::memory_order_relaxed);
+			return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+		}
+
+		bool empty() const
+		{
+			return size() == 0;
+		}
+
+		// Returns false if the buffer is full
+		bool try_push(T const& data)
+		{
+			cell* c;
+			size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				c = &buffer_[pos & buffer_mask_];
+				const size_t seq = c->sequence.load(std::memory_order_acquire);
+				const intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+				if (dif == 0)
+				{
+					if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (dif < 0)
+				{
+					return false;
+				}
+				else
+				{
+					pos = enqueue_pos_.load(std::memory_order_relaxed);
+				}
+			}
+			c->data = data;
+			c->sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Returns false if the buffer is empty
+		bool try_pop(T& data)
+		{
+			cell* c;
+			size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				c = &buffer_[pos & buffer_mask_];
+				const size_t seq = c->sequence.load(std::memory_order_acquire);
+				const intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+				if (dif == 0)
+				{
+					if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (dif < 0)
+				{
+					return false;
+				}
+				else
+				{
+					pos = dequeue_pos_.load(std::memory_order_relaxed);
+				}
+			}
+			data = c->data;
+			c->sequence.store(pos + buffer_mask_ + 1, std::memory_order_release);
+			return true;
+		}
+	};
+
+} // namespace rosbridge2cpp
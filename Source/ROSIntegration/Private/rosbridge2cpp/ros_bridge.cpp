@@ -1,16 +1,30 @@
 
 #include "ros_bridge.h"
 #include "ros_topic.h"
+#include <algorithm>
 #include <bson.h>
 
 namespace rosbridge2cpp {
 
 	static const std::chrono::seconds SendThreadFreezeTimeout = std::chrono::seconds(5);
-	unsigned long ROSCallbackHandle_id_counter = 1;
+	// The publisher queue thread wakes up at least this often to keep LastDataSendTime up to date
+	static const std::chrono::milliseconds PublisherQueueIdleTimeout = std::chrono::milliseconds(500);
+	std::atomic<unsigned long> ROSCallbackHandle_id_counter(1);
 
 	ROSBridge::~ROSBridge()
 	{
-		run_publisher_queue_thread_ = false;
+		// Stopped first, a receiver thread that is blocked on a full worker queue drops its message and returns.
+		// Otherwise unregistering would wait for it while it waits for the workers.
+		incoming_message_dispatcher_.Stop();
+		// the transport usually outlives the bridge, its receiver thread must not dispatch into it anymore
+		transport_layer_.UnregisterIncomingMessageCallbacks();
+
+		{
+			std::lock_guard<std::mutex> lock(change_publisher_queues_mutex_);
+			run_publisher_queue_thread_ = false;
+		}
+		publisher_queues_changed_.notify_all();
+
 		if (publisher_queue_thread_.joinable())
 		{
 			bool waitForThread = (std::chrono::system_clock::now() - LastDataSendTime < SendThreadFreezeTimeout);
@@ -24,18 +38,69 @@ namespace rosbridge2cpp {
 			}
 		}
 
-		for (auto& queue : publisher_queues_)
+		// remaining messages are destroyed by the PublisherQueue instances
+	}
+
+	PublisherQueue::PublisherQueue(int queue_size, PublisherPriority priority)
+	: priority_(priority)
+	, messages_(queue_size > DefaultCapacity ? queue_size : DefaultCapacity)
+	, queue_size_(0)
+	{
+		SetQueueSize(queue_size);
+	}
+
+	PublisherQueue::~PublisherQueue()
+	{
+		OutgoingMessage* message;
+		while (messages_.try_pop(message))
+		{
+			delete message;
+		}
+	}
+
+	void PublisherQueue::SetQueueSize(int queue_size)
+	{
+		const size_t requested_size = queue_size > 0 ? (size_t)queue_size : (size_t)DefaultCapacity;
+		if (requested_size > messages_.capacity())
+		{
+			std::cerr << "[ROSBridge] Publisher queue size " << requested_size << " exceeds the capacity of the topic queue, which has been created with "
+				<< messages_.capacity() << " messages. Using " << messages_.capacity() << "." << std::endl;
+		}
+		queue_size_ = std::min(requested_size, messages_.capacity());
+	}
+
+	int PublisherQueue::Push(OutgoingMessage* message)
+	{
+		int num_dropped = 0;
+		OutgoingMessage* oldest;
+
+		// make space if necessary
+		while (messages_.size() >= queue_size_ && messages_.try_pop(oldest))
+		{
+			delete oldest;
+			++num_dropped;
+		}
+
+		// other producers might have filled the space in the meantime
+		while (!messages_.try_push(message))
 		{
-			while (queue.size())
+			if (messages_.try_pop(oldest))
 			{
-				bson_destroy(queue.front());
-				queue.pop();
+				delete oldest;
+				++num_dropped;
 			}
 		}
+
+		return num_dropped;
+	}
+
+	bool PublisherQueue::Pop(OutgoingMessage*& message)
+	{
+		return messages_.try_pop(message);
 	}
 
 	bool ROSBridge::SendMessage(std::string data) {
-		spinlock::scoped_lock_wait_for_short_task lock(transport_layer_access_mutex_);
+		scoped_synchronous_send_lock lock(*this);
 		return transport_layer_.SendMessage(data);
 	}
 
@@ -56,7 +121,7 @@ namespace rosbridge2cpp {
 			}
 			const uint8_t *bson_data = bson_get_data(&bson);
 			uint32_t bson_size = bson.len;
-			spinlock::scoped_lock_wait_for_short_task lock(transport_layer_access_mutex_);
+			scoped_synchronous_send_lock lock(*this);
 			bool retval = transport_layer_.SendMessage(bson_data, bson_size);
 			bson_destroy(&bson);
 			return retval;
@@ -76,7 +141,7 @@ namespace rosbridge2cpp {
 
 			const uint8_t *bson_data = bson_get_data(&message);
 			uint32_t bson_size = message.len;
-			spinlock::scoped_lock_wait_for_short_task lock(transport_layer_access_mutex_);
+			scoped_synchronous_send_lock lock(*this);
 			bool retval = transport_layer_.SendMessage(bson_data, bson_size);
 			bson_destroy(&message); // TODO needed?
 			return retval;
@@ -110,7 +175,12 @@ namespace rosbridge2cpp {
 		return SendMessage(str_repr);
 	}
 
-	bool ROSBridge::QueueMessage(const std::string& topic_name, int queue_size, ROSBridgePublishMsg& msg)
+	bool ROSBridge::QueueMessage(const std::string& topic_name, int queue_size, ROSBridgePublishMsg& msg, PublisherPriority priority)
+	{
+		return QueueMessage(*GetPublisherQueue(topic_name, queue_size, priority), msg);
+	}
+
+	bool ROSBridge::QueueMessage(PublisherQueue& queue, ROSBridgePublishMsg& msg)
 	{
 		assert(bson_only_mode_); // queueing is not supported for json data
 
@@ -123,34 +193,71 @@ namespace rosbridge2cpp {
 		bson_init(message);
 		msg.ToBSON(*message);
 
+		return QueueMessage(queue, message);
+	}
+
+	bool ROSBridge::QueueMessage(PublisherQueue& queue, bson_t* message)
+	{
+		return QueueMessage(queue, new OutgoingMessage(message));
+	}
+
+	bool ROSBridge::QueueMessage(PublisherQueue& queue, OutgoingMessage* message)
+	{
+		assert(bson_only_mode_); // queueing is not supported for json data
+
+		if (!run_publisher_queue_thread_)
 		{
-			spinlock::scoped_lock_wait_for_short_task lock(change_publisher_queues_mutex_);
-			if (publisher_topics_.find(topic_name) == publisher_topics_.end())
-			{
-				publisher_topics_[topic_name] = publisher_queues_.size();
-				publisher_queues_.push_back(std::queue<bson_t*>());
-			}
+			delete message;
+			return false;
+		}
 
-			auto& queue = publisher_queues_[publisher_topics_[topic_name]];
-			if (queue_size > 0 && queue.size() >= queue_size) // make space if necessary
-			{
-				bson_destroy(queue.front());
-				queue.pop();
-			}
+		const int num_dropped = queue.Push(message);
+		num_queued_messages_ += 1 - num_dropped;
 
-			queue.push(message);
+		// Only take the lock if the queue thread might be waiting for new messages.
+		// Both sides access num_queued_messages_ and publisher_queue_thread_waiting_ in sequentially consistent order,
+		// so either the queue thread sees the new message or we see that it is waiting.
+		if (publisher_queue_thread_waiting_)
+		{
+			std::lock_guard<std::mutex> lock(change_publisher_queues_mutex_);
+			publisher_queues_changed_.notify_one();
 		}
 
 		return true;
 	}
 
+	std::shared_ptr<PublisherQueue> ROSBridge::GetPublisherQueue(const std::string& topic_name, int queue_size, PublisherPriority priority)
+	{
+		std::lock_guard<std::mutex> lock(change_publisher_queues_mutex_);
+
+		auto topic_it = publisher_topics_.find(topic_name);
+		if (topic_it == publisher_topics_.end())
+		{
+			topic_it = publisher_topics_.emplace(topic_name, std::make_shared<PublisherQueue>(queue_size, priority)).first;
+			++publisher_topics_version_;
+		}
+		else
+		{
+			topic_it->second->SetQueueSize(queue_size);
+			if (topic_it->second->priority_ != priority) // another ROSTopic instance changed the priority of this topic
+			{
+				topic_it->second->priority_ = priority;
+				++publisher_topics_version_;
+			}
+		}
+
+		return topic_it->second;
+	}
+
 	void ROSBridge::HandleIncomingPublishMessage(ROSBridgePublishMsg &data)
 	{
-		spinlock::scoped_lock_wait_for_short_task lock(change_topics_mutex_);
+		// keeps the callbacks alive, even if they are unregistered in the meantime
+		std::shared_ptr<const TopicCallbackTable> topic_callbacks = std::atomic_load(&registered_topic_callbacks_);
 
 		// Incoming topic message - dispatch to correct callback
 		std::string &incoming_topic_name = data.topic_;
-		if (registered_topic_callbacks_.find(incoming_topic_name) == registered_topic_callbacks_.end()) {
+		auto topic_callbacks_it = topic_callbacks->find(incoming_topic_name);
+		if (topic_callbacks_it == topic_callbacks->end()) {
 			std::cerr << "[ROSBridge] Received message for topic " << incoming_topic_name << " where no callback has been registered before" << std::endl;
 			return;
 		}
@@ -169,7 +276,7 @@ namespace rosbridge2cpp {
 		}
 
 		// Iterate over all registered callbacks for the given topic
-		for (auto& topic_callback : registered_topic_callbacks_.find(incoming_topic_name)->second) {
+		for (auto& topic_callback : *topic_callbacks_it->second) {
 			topic_callback.GetFunction()(data);
 		}
 		return;
@@ -179,47 +286,61 @@ namespace rosbridge2cpp {
 	{
 		std::string &incoming_service_id = data.id_;
 
-		auto service_response_callback_it = registered_service_callbacks_.find(incoming_service_id);
-
-		if (service_response_callback_it == registered_service_callbacks_.end()) {
-			std::cerr << "[ROSBridge] Received response for service id " << incoming_service_id << "where no callback has been registered before" << std::endl;
-			return;
-		}
+		FunVrROSServiceResponseMsg service_response_callback;
+		{
+			std::lock_guard<std::mutex> lock(change_service_callbacks_mutex_);
+			auto service_response_callback_it = registered_service_callbacks_.find(incoming_service_id);
 
-		// Execute the callback for the given service id
-		service_response_callback_it->second(data);
+			if (service_response_callback_it == registered_service_callbacks_.end()) {
+				std::cerr << "[ROSBridge] Received response for service id " << incoming_service_id << "where no callback has been registered before" << std::endl;
+				return;
+			}
 
-		// Delete the callback.
-		// Every call_service will create a new id
-		registered_service_callbacks_.erase(service_response_callback_it);
+			// Every call_service will create a new id, so the callback is removed
+			service_response_callback = std::move(service_response_callback_it->second);
+			registered_service_callbacks_.erase(service_response_callback_it);
+		}
 
+		// Execute the callback for the given service id, without the lock, it may call the next service
+		service_response_callback(data);
 	}
 
 	void ROSBridge::HandleIncomingServiceRequestMessage(ROSBridgeCallServiceMsg &data)
 	{
 		std::string &incoming_service = data.service_;
 
+		// the callbacks are copied and run without the lock, they send the response
 		if (bson_only_mode()) {
-			auto service_request_callback_it = registered_service_request_callbacks_bson_.find(incoming_service);
+			FunVrROSCallServiceMsgrROSServiceResponseMsg service_request_callback;
+			{
+				std::lock_guard<std::mutex> lock(change_service_callbacks_mutex_);
+				auto service_request_callback_it = registered_service_request_callbacks_bson_.find(incoming_service);
 
-			if (service_request_callback_it == registered_service_request_callbacks_bson_.end()) {
-				std::cerr << "[ROSBridge] Received service request for service :" << incoming_service << " where no callback has been registered before" << std::endl;
-				return;
+				if (service_request_callback_it == registered_service_request_callbacks_bson_.end()) {
+					std::cerr << "[ROSBridge] Received service request for service :" << incoming_service << " where no callback has been registered before" << std::endl;
+					return;
+				}
+				service_request_callback = service_request_callback_it->second;
 			}
-			service_request_callback_it->second(data);
+			service_request_callback(data);
 		}
 		else
 		{
-			auto service_request_callback_it = registered_service_request_callbacks_.find(incoming_service);
+			FunVrROSCallServiceMsgrROSServiceResponseMsgrAllocator service_request_callback;
+			{
+				std::lock_guard<std::mutex> lock(change_service_callbacks_mutex_);
+				auto service_request_callback_it = registered_service_request_callbacks_.find(incoming_service);
 
-			if (service_request_callback_it == registered_service_request_callbacks_.end()) {
-				std::cerr << "[ROSBridge] Received service request for service :" << incoming_service << " where no bson callback has been registered before" << std::endl;
-				return;
+				if (service_request_callback_it == registered_service_request_callbacks_.end()) {
+					std::cerr << "[ROSBridge] Received service request for service :" << incoming_service << " where no bson callback has been registered before" << std::endl;
+					return;
+				}
+				service_request_callback = service_request_callback_it->second;
 			}
 			rapidjson::Document response_allocator;
 
 			// Execute the callback for the given service id
-			service_request_callback_it->second(data, response_allocator.GetAllocator());
+			service_request_callback(data, response_allocator.GetAllocator());
 		}
 	}
 
@@ -227,40 +348,52 @@ namespace rosbridge2cpp {
 
 	void ROSBridge::IncomingMessageCallback(bson_t &bson)
 	{
-		//ROSBridgeMsg msg;
-		//msg.FromBSON(bson);
-		//HandleIncomingMessage(msg);
+		// Messages of a topic are handled in order on the same worker.
+		// All other messages, i.e. service calls and responses, share the empty key and are handled in order on one worker.
+		ROSBridgeEnvelope envelope;
+		envelope.Decode(bson);
+		std::string key;
+		if (envelope.op == ROSBridgeMsg::PUBLISH && envelope.topic) {
+			key.assign(envelope.topic, envelope.topic_length);
+		}
+		// dropped once the dispatcher has been stopped, the bridge is being destroyed then.
+		// The worker gets the envelope along with the message, so it isn't decoded again.
+		incoming_message_dispatcher_.Dispatch(key, bson, envelope);
+	}
 
+	void ROSBridge::HandleIncomingMessage(bson_t &bson, const ROSBridgeEnvelope &envelope)
+	{
 		// Check the message type and dispatch the message properly
-		//
-		// Incoming Topic messages
-		bool key_found = false;
-
-		if (Helper::get_utf8_by_key("op", bson, key_found) == "publish") {
+		switch (envelope.op) {
+		case ROSBridgeMsg::PUBLISH: {
+			// Incoming Topic messages
 			ROSBridgePublishMsg m;
-			if (m.FromBSON(bson)) {
+			if (m.FromBSON(bson, envelope)) {
 				HandleIncomingPublishMessage(m);
 				return;
 			}
-
 			std::cerr << "Failed to parse publish message into class. Skipping message." << std::endl;
+			break;
 		}
-
-		// Service responses for service we called earlier
-		if (Helper::get_utf8_by_key("op", bson, key_found) == "service_response") {
+		case ROSBridgeMsg::SERVICE_RESPONSE: {
+			// Service responses for service we called earlier
 			ROSBridgeServiceResponseMsg m;
-			if (m.FromBSON(bson)) {
+			if (m.FromBSON(bson, envelope)) {
 				HandleIncomingServiceResponseMessage(m);
 				return;
 			}
 			std::cerr << "Failed to parse service_response message into class. Skipping message." << std::endl;
+			break;
 		}
-
-		// Service Requests to a service that we advertised in ROSService
-		if (Helper::get_utf8_by_key("op", bson, key_found) == "call_service") {
+		case ROSBridgeMsg::CALL_SERVICE: {
+			// Service Requests to a service that we advertised in ROSService
 			ROSBridgeCallServiceMsg m;
-			m.FromBSON(bson);
+			m.FromBSON(bson, envelope);
 			HandleIncomingServiceRequestMessage(m);
+			break;
+		}
+		default:
+			break;
 		}
 	}
 
@@ -303,6 +436,7 @@ namespace rosbridge2cpp {
 	bool ROSBridge::Init(std::string ip_addr, int port)
 	{
 		if (bson_only_mode()) {
+			incoming_message_dispatcher_.Start(0, [this](bson_t &bson, const ROSBridgeEnvelope &envelope) { HandleIncomingMessage(bson, envelope); });
 			auto fun = [this](bson_t &bson) { IncomingMessageCallback(bson); };
 
 			transport_layer_.SetTransportMode(ITransportLayer::BSON);
@@ -328,43 +462,67 @@ namespace rosbridge2cpp {
 
 	void ROSBridge::RegisterTopicCallback(std::string topic_name, ROSCallbackHandle<FunVrROSPublishMsg>& callback_handle)
 	{
-		spinlock::scoped_lock_wait_for_short_task lock(change_topics_mutex_);
-		registered_topic_callbacks_[topic_name].push_back(callback_handle);
+		std::lock_guard<std::mutex> lock(change_topics_mutex_);
+
+		auto topic_callbacks = std::make_shared<TopicCallbackTable>(*registered_topic_callbacks_);
+		auto callbacks = std::make_shared<TopicCallbacks>();
+		auto callbacks_it = topic_callbacks->find(topic_name);
+		if (callbacks_it != topic_callbacks->end()) {
+			*callbacks = *callbacks_it->second;
+		}
+		callbacks->push_back(callback_handle);
+		(*topic_callbacks)[topic_name] = callbacks;
+
+		std::atomic_store(&registered_topic_callbacks_, std::shared_ptr<const TopicCallbackTable>(topic_callbacks));
 	}
 
 	void ROSBridge::RegisterServiceCallback(std::string service_call_id, FunVrROSServiceResponseMsg fun)
 	{
+		std::lock_guard<std::mutex> lock(change_service_callbacks_mutex_);
 		registered_service_callbacks_[service_call_id] = fun;
 	}
 
 	void ROSBridge::RegisterServiceRequestCallback(std::string service_name, FunVrROSCallServiceMsgrROSServiceResponseMsgrAllocator fun)
 	{
+		std::lock_guard<std::mutex> lock(change_service_callbacks_mutex_);
 		registered_service_request_callbacks_[service_name] = fun;
 	}
 
 	void ROSBridge::RegisterServiceRequestCallback(std::string service_name, FunVrROSCallServiceMsgrROSServiceResponseMsg fun)
 	{
+		std::lock_guard<std::mutex> lock(change_service_callbacks_mutex_);
 		registered_service_request_callbacks_bson_[service_name] = fun;
 	}
 
 	bool ROSBridge::UnregisterTopicCallback(std::string topic_name, const ROSCallbackHandle<FunVrROSPublishMsg>& callback_handle)
 	{
-		spinlock::scoped_lock_wait_for_short_task lock(change_topics_mutex_);
+		std::lock_guard<std::mutex> lock(change_topics_mutex_);
 
-		if (registered_topic_callbacks_.find(topic_name) == registered_topic_callbacks_.end()) {
+		auto callbacks_it = registered_topic_callbacks_->find(topic_name);
+		if (callbacks_it == registered_topic_callbacks_->end()) {
 			std::cerr << "[ROSBridge] UnregisterTopicCallback called but given topic name '" << topic_name << "' not in map." << std::endl;
 			return false;
 		}
 
-		std::list<ROSCallbackHandle<FunVrROSPublishMsg>> &r_list_of_callbacks = registered_topic_callbacks_.find(topic_name)->second;
+		const TopicCallbacks &r_list_of_callbacks = *callbacks_it->second;
 
-		for (std::list<ROSCallbackHandle<FunVrROSPublishMsg>>::iterator topic_callback_it = r_list_of_callbacks.begin();
+		for (auto topic_callback_it = r_list_of_callbacks.begin();
 			topic_callback_it != r_list_of_callbacks.end();
 			++topic_callback_it) {
 
 			if (*topic_callback_it == callback_handle) {
 				std::cout << "[ROSBridge] Found CB in UnregisterTopicCallback. Deleting it ... " << std::endl;
-				r_list_of_callbacks.erase(topic_callback_it);
+				auto callbacks = std::make_shared<TopicCallbacks>(r_list_of_callbacks);
+				callbacks->erase(callbacks->begin() + (topic_callback_it - r_list_of_callbacks.begin()));
+
+				auto topic_callbacks = std::make_shared<TopicCallbackTable>(*registered_topic_callbacks_);
+				if (callbacks->empty()) {
+					topic_callbacks->erase(topic_name);
+				}
+				else {
+					(*topic_callbacks)[topic_name] = callbacks;
+				}
+				std::atomic_store(&registered_topic_callbacks_, std::shared_ptr<const TopicCallbackTable>(topic_callbacks));
 				return true;
 			}
 		}
@@ -375,7 +533,13 @@ namespace rosbridge2cpp {
 	{
 		int return_value = 0;
 		int num_retries_left = 10;
-		float sleep_duration = 0.2f;
+		float sleep_duration = 0.0f;
+
+		// Local copy of the publisher queues, grouped by priority class.
+		// Refreshed whenever publisher_topics_version_ changes.
+		std::vector<std::shared_ptr<PublisherQueue>> queues_by_priority[NUM_PUBLISHER_PRIORITIES];
+		size_t current_queue[NUM_PUBLISHER_PRIORITIES] = {}; // round robin position within each class
+		unsigned int queues_version = publisher_topics_version_ - 1;
 
 		while (run_publisher_queue_thread_)
 		{
@@ -383,45 +547,70 @@ namespace rosbridge2cpp {
 
 			if (sleep_duration > 0.0f)
 			{
+				// back off after a failed send
 				std::this_thread::sleep_for(std::chrono::microseconds((long long)(sleep_duration * 1000000.0)));
 				sleep_duration = 0.0f;
 			}
 
-			bson_t* msg;
+			if (num_queued_messages_ <= 0)
 			{
-				spinlock::scoped_lock_wait_for_short_task lock(change_publisher_queues_mutex_);
-				current_publisher_queue_++;
-				if (current_publisher_queue_ >= publisher_queues_.size())
-				{
-					current_publisher_queue_ = 0;
-					// Enforce sleep once every topic was handled to allow
-					// synchronous ROSBridge calls (e.g. Subscribe, Advertise).
-					sleep_duration = 0.01f;
+				std::unique_lock<std::mutex> lock(change_publisher_queues_mutex_);
+				publisher_queue_thread_waiting_ = true;
+				publisher_queues_changed_.wait_for(lock, PublisherQueueIdleTimeout,
+					[this] { return num_queued_messages_ > 0 || !run_publisher_queue_thread_; });
+				publisher_queue_thread_waiting_ = false;
+				continue;
+			}
 
-					if (publisher_queues_.size() == 0)
-					{
-						sleep_duration = 0.1f;
-						continue;
-					}
+			if (queues_version != publisher_topics_version_)
+			{
+				std::lock_guard<std::mutex> lock(change_publisher_queues_mutex_);
+				queues_version = publisher_topics_version_;
+				for (auto& queues : queues_by_priority)
+				{
+					queues.clear();
 				}
-				auto& queue = publisher_queues_[current_publisher_queue_];
-				if (queue.size())
+				for (auto& topic : publisher_topics_)
 				{
-					msg = queue.front();
-					queue.pop();
+					queues_by_priority[(int)topic.second->priority_.load()].push_back(topic.second);
 				}
-				else
+			}
+
+			// Pick the highest priority class with queued messages and
+			// serve its topics round robin, starting after the topic that was served last.
+			// This is re-evaluated after every message, so control topics overtake bulk topics between two messages.
+			OutgoingMessage* msg = nullptr;
+			for (int p = NUM_PUBLISHER_PRIORITIES - 1; p >= 0 && !msg; --p)
+			{
+				auto& queues = queues_by_priority[p];
+				for (size_t i = 0; i < queues.size(); ++i)
 				{
-					continue;
+					current_queue[p] = (current_queue[p] + 1) % queues.size();
+					if (queues[current_queue[p]]->Pop(msg))
+					{
+						--num_queued_messages_;
+						break;
+					}
 				}
 			}
 
-			const uint8_t* bson_data = bson_get_data(msg);
-			uint32_t bson_size = msg->len;
+			if (!msg)
+			{
+				// a producer has counted its message but not yet made it visible
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Let synchronous calls (e.g. Subscribe, Advertise) onto the socket first
+			while (waiting_synchronous_senders_ > 0)
+			{
+				std::this_thread::yield();
+			}
+
 			{
 				spinlock::scoped_lock_wait_for_long_task lock(transport_layer_access_mutex_);
-				const bool success = transport_layer_.SendMessage(bson_data, bson_size);
-				bson_destroy(msg);
+				const bool success = msg->Send(transport_layer_);
+				delete msg; // releases attached binary data as soon as it has been sent
 				if (!success)
 				{
 					num_retries_left--;
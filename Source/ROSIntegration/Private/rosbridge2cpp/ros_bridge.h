@@ -6,13 +6,20 @@
 #include <functional>
 #include <unordered_map>
 #include <list>
-#include <queue>
+#include <vector>
+#include <memory>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include <stdio.h>
 #include "types.h"
 #include "helper.h"
 #include "spinlock.h"
+#include "incoming_message_dispatcher.h"
+#include "outgoing_message.h"
+#include "ring_buffer.h"
 
 #include "itransport_layer.h"
 
@@ -35,6 +42,42 @@ using json = rapidjson::Document;
 
 namespace rosbridge2cpp {
 
+	// The outgoing messages of one topic that wait for the publisher queue thread.
+	// Publishing threads push without taking a lock. When the queue already holds
+	// queue_size messages, the oldest message is dropped to make space.
+	//
+	// All ROSTopics that publish on a topic share its queue, each of them sets the queue size when it
+	// advertises. The ring holds at least DefaultCapacity messages, so that a topic created with a small
+	// queue_size can still be given a larger one. Larger sizes than the capacity are clamped.
+	class PublisherQueue {
+	public:
+		// queue_size <= 0 used to request an unbounded queue, it holds up to DefaultCapacity messages now
+		PublisherQueue(int queue_size, PublisherPriority priority);
+		~PublisherQueue();
+
+		static const int DefaultCapacity = 1024;
+
+		// Takes ownership of message.
+		// Returns the number of messages that have been dropped to make space.
+		int Push(OutgoingMessage* message);
+
+		// Only called by the publisher queue thread
+		bool Pop(OutgoingMessage*& message);
+
+		bool Empty() const { return messages_.empty(); }
+
+		void SetQueueSize(int queue_size);
+
+		std::atomic<PublisherPriority> priority_;
+
+	private:
+		ring_buffer<OutgoingMessage*> messages_;
+		std::atomic<size_t> queue_size_;
+
+		PublisherQueue(PublisherQueue const &);
+		PublisherQueue & operator=(PublisherQueue const &);
+	};
+
 	/**
 	 * The main rosbridge2cpp class that connects to the rosbridge server.
 	 * The library is inspired by [roslibjs](http://wiki.ros.org/roslibjs),
@@ -65,7 +108,21 @@ namespace rosbridge2cpp {
 
 		bool SendMessage(ROSBridgeMsg &msg);
 
-		bool QueueMessage(const std::string& topic_name, int queue_size, ROSBridgePublishMsg& msg);
+		// Queue a message for sending on the publisher queue thread.
+		// The topic is served according to the given priority class (see PublisherPriority).
+		bool QueueMessage(const std::string& topic_name, int queue_size, ROSBridgePublishMsg& msg, PublisherPriority priority = PublisherPriority::NORMAL);
+
+		// Lock-free variant of QueueMessage for a queue obtained from GetPublisherQueue.
+		bool QueueMessage(PublisherQueue& queue, ROSBridgePublishMsg& msg);
+
+		// Queue an already serialized rosbridge message (see ROSBridgePublishMsg::BeginBSON).
+		// Takes ownership of message, also when queueing fails.
+		bool QueueMessage(PublisherQueue& queue, bson_t* message);
+		bool QueueMessage(PublisherQueue& queue, OutgoingMessage* message);
+
+		// Returns the publisher queue of the given topic and creates it if necessary.
+		// Publishers should keep the returned queue to avoid the lookup on every message.
+		std::shared_ptr<PublisherQueue> GetPublisherQueue(const std::string& topic_name, int queue_size, PublisherPriority priority = PublisherPriority::NORMAL);
 
 
 		// Registration function for topic callbacks.
@@ -96,7 +153,7 @@ namespace rosbridge2cpp {
 
 		// An ID Counter that will be used to generate increasing
 		// IDs for service/topic etc. messages
-		long id_counter = 0;
+		std::atomic<long> id_counter{ 0 };
 
 		// Returns true if the bson only mode is activated
 		bool bson_only_mode() {
@@ -108,6 +165,10 @@ namespace rosbridge2cpp {
 		// will be in BSON, instead of JSON
 		void enable_bson_mode() { bson_only_mode_ = true; }
 
+		// Incoming messages are handled on the worker threads of this dispatcher in BSON mode.
+		// Use it to monitor the queue depths.
+		const IncomingMessageDispatcher& GetIncomingMessageDispatcher() const { return incoming_message_dispatcher_; }
+
 	private:
 		// Callback function for the used ITransportLayer.
 		// It receives the received json that was contained
@@ -116,8 +177,13 @@ namespace rosbridge2cpp {
 		// @pre This method assumes a valid json variable
 		void IncomingMessageCallback(json &data);
 
+		// Called on the receiver thread of the transport layer.
+		// Hands the message to the dispatcher worker of its topic or service.
 		void IncomingMessageCallback(bson_t &bson);
 
+		// Parses an incoming message and runs the registered callbacks
+		void HandleIncomingMessage(bson_t &bson, const ROSBridgeEnvelope &envelope);
+
 		// Handler Method for reply packet
 		void HandleIncomingPublishMessage(ROSBridgePublishMsg &data);
 
@@ -129,23 +195,59 @@ namespace rosbridge2cpp {
 
 		int RunPublisherQueueThread();
 
+		// Locks the transport layer for a message that is sent synchronously
+		// (e.g. Advertise, Subscribe). While such a sender is waiting, the
+		// publisher queue thread steps aside after its current message instead
+		// of grabbing the transport layer again.
+		class scoped_synchronous_send_lock {
+		public:
+			explicit scoped_synchronous_send_lock(ROSBridge& ros) : ros_(ros)
+			{
+				++ros_.waiting_synchronous_senders_;
+				ros_.transport_layer_access_mutex_.lock(true);
+				--ros_.waiting_synchronous_senders_;
+			}
+
+			~scoped_synchronous_send_lock()
+			{
+				ros_.transport_layer_access_mutex_.unlock();
+			}
+
+		private:
+			ROSBridge& ros_;
+			scoped_synchronous_send_lock(scoped_synchronous_send_lock const &);
+			scoped_synchronous_send_lock & operator=(scoped_synchronous_send_lock const &);
+		};
+
 		ITransportLayer &transport_layer_;
-		std::unordered_map<std::string, std::list<ROSCallbackHandle<FunVrROSPublishMsg>>> registered_topic_callbacks_;
+
+		// Topic callbacks are replaced as a whole (copy-on-write) whenever a callback is registered or unregistered.
+		// Incoming messages are dispatched on a snapshot without taking a lock,
+		// so callbacks may still run shortly after they have been unregistered.
+		typedef std::vector<ROSCallbackHandle<FunVrROSPublishMsg>> TopicCallbacks;
+		typedef std::unordered_map<std::string, std::shared_ptr<const TopicCallbacks>> TopicCallbackTable;
+		std::shared_ptr<const TopicCallbackTable> registered_topic_callbacks_ = std::make_shared<const TopicCallbackTable>(); // only accessed with std::atomic_load/atomic_store
 		std::unordered_map<std::string, FunVrROSServiceResponseMsg> registered_service_callbacks_;
 		std::unordered_map<std::string, FunVrROSCallServiceMsgrROSServiceResponseMsgrAllocator> registered_service_request_callbacks_;
 		std::unordered_map<std::string, FunVrROSCallServiceMsgrROSServiceResponseMsg> registered_service_request_callbacks_bson_;
 		bool bson_only_mode_ = false;
 
 		spinlock transport_layer_access_mutex_;
+		std::atomic<int> waiting_synchronous_senders_{ 0 };
+
+		std::mutex change_topics_mutex_; // serializes changes of registered_topic_callbacks_
+		std::mutex change_service_callbacks_mutex_; // guards the registered_service_* maps, the callbacks run without it
 
-		spinlock change_topics_mutex_;
+		IncomingMessageDispatcher incoming_message_dispatcher_;
 
 		std::thread publisher_queue_thread_;
-		spinlock change_publisher_queues_mutex_;
-		std::unordered_map<std::string, int> publisher_topics_; // points to index in publisher_queues_
-		std::vector<std::queue<bson_t*>> publisher_queues_;	 // data to publish on the queue thread
-		int current_publisher_queue_ = 0;
-		bool run_publisher_queue_thread_ = true;
+		std::mutex change_publisher_queues_mutex_; // guards publisher_topics_ and the wake up of the queue thread
+		std::condition_variable publisher_queues_changed_; // signaled when messages are queued and on shutdown
+		std::unordered_map<std::string, std::shared_ptr<PublisherQueue>> publisher_topics_;
+		std::atomic<unsigned int> publisher_topics_version_{ 0 }; // incremented when a queue is added or changes its priority
+		std::atomic<long> num_queued_messages_{ 0 }; // total number of messages in all publisher queues
+		std::atomic<bool> publisher_queue_thread_waiting_{ false };
+		std::atomic<bool> run_publisher_queue_thread_{ true };
 		std::chrono::system_clock::time_point LastDataSendTime; // watchdog for send thread. Socket sometimes blocks infinitely.
 	};
 }
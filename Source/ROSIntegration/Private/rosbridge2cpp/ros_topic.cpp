@@ -29,6 +29,21 @@ namespace rosbridge2cpp {
 
 		if (subscribe_id_ != "")
 		{
+			if (receive_queue_policy_ != ReceiveQueuePolicy::NONE) {
+				// Register the queue in ROSBridge, which passes the messages on to callback
+				auto queue = SubscriberQueue::Start(receive_queue_policy_, queue_size_, callback);
+				std::weak_ptr<SubscriberQueue> weak_queue = queue;
+				FunVrROSPublishMsg push_to_queue = [weak_queue](const ROSBridgePublishMsg &message) {
+					if (auto queue = weak_queue.lock()) {
+						queue->Push(message);
+					}
+				};
+				ROSCallbackHandle<FunVrROSPublishMsg> handle(push_to_queue);
+				subscriber_queues_.emplace_back(handle, queue);
+				ros_.RegisterTopicCallback(topic_name_, handle);
+				return handle;
+			}
+
 			// Register callback in ROSBridge
 			ROSCallbackHandle<FunVrROSPublishMsg> handle(callback);
 			ros_.RegisterTopicCallback(topic_name_, handle); // Register callback in ROSBridge
@@ -51,6 +66,15 @@ namespace rosbridge2cpp {
 			return false;
 		}
 
+		// stops the delivery thread of the queue after its current callback
+		for (auto it = subscriber_queues_.begin(); it != subscriber_queues_.end(); ++it) {
+			if (it->first == callback_handle) {
+				it->second->Stop();
+				subscriber_queues_.erase(it);
+				break;
+			}
+		}
+
 		--subscription_counter_;
 
 		if (subscription_counter_ > 0)
@@ -151,7 +175,7 @@ namespace rosbridge2cpp {
 		cmd.msg_json_ = message;
 		cmd.latch_ = latch_;
 
-		return ros_.QueueMessage(topic_name_, queue_size_, cmd);
+		return ros_.QueueMessage(GetPublisherQueue(), cmd);
 	}
 
 	bool ROSTopic::Publish(bson_t *message)
@@ -172,7 +196,49 @@ namespace rosbridge2cpp {
 		cmd.msg_bson_ = message;
 		cmd.latch_ = latch_;
 
-		return ros_.QueueMessage(topic_name_, queue_size_, cmd);
+		return ros_.QueueMessage(GetPublisherQueue(), cmd);
+	}
+
+	bool ROSTopic::Publish(const FunBrBSON &append_msg)
+	{
+		if (!is_advertised_) {
+			if (!Advertise()) {
+				return false;
+			}
+		}
+
+		ROSBridgePublishMsg cmd(true);
+		cmd.id_ = GeneratePublishID();
+		cmd.topic_ = topic_name_;
+		cmd.latch_ = latch_;
+
+		// Messages of a topic usually keep their size, so the envelope is allocated with the size of the last one.
+		// This way the message content is not copied again while the buffer grows.
+		bson_t *bson = bson_sized_new(last_message_size_);
+		OutgoingMessage *message = new OutgoingMessage(bson);
+		bson_t msg;
+		if (!cmd.BeginBSON(*bson, msg)) {
+			delete message;
+			return false;
+		}
+		message->Begin(msg);
+		const bool success = append_msg(msg);
+		message->End();
+		if (!success || !bson_append_document_end(bson, &msg)) {
+			delete message;
+			return false;
+		}
+		last_message_size_ = bson->len;
+
+		return ros_.QueueMessage(GetPublisherQueue(), message);
+	}
+
+	PublisherQueue& ROSTopic::GetPublisherQueue()
+	{
+		std::call_once(publisher_queue_lookup_, [this] {
+			publisher_queue_ = ros_.GetPublisherQueue(topic_name_, queue_size_, priority_);
+		});
+		return *publisher_queue_;
 	}
 
 	std::string ROSTopic::GeneratePublishID()
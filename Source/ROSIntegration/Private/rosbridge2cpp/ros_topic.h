@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <list>
+#include <memory>
+#include <mutex>
 
 #include "rapidjson/document.h"
 
 #include "ros_bridge.h"
+#include "subscriber_queue.h"
 #include "types.h"
 #include "helper.h"
 #include "messages/rosbridge_advertise_msg.h"
@@ -19,14 +23,23 @@ namespace rosbridge2cpp{
 
 	class ROSTopic {
 	public:
-		ROSTopic(ROSBridge &ros, std::string topic_name, std::string message_type, int queue_size = 10)
+		// queue_size limits the messages that wait to be published, 0 allows up to PublisherQueue::DefaultCapacity (1024)
+		ROSTopic(ROSBridge &ros, std::string topic_name, std::string message_type, int queue_size = 10, PublisherPriority priority = PublisherPriority::NORMAL)
 		: ros_(ros)
 		, topic_name_(topic_name)
 		, message_type_(message_type)
 		, queue_size_(queue_size)
+		, priority_(priority)
 		{
 		}
 
+		~ROSTopic()
+		{
+			for (auto& subscriber_queue : subscriber_queues_) {
+				subscriber_queue.second->Stop();
+			}
+		}
+
 	// Subscribes to a ROS Topic and registers a callback function
 	// for incoming messages
 	// Multiple callback functions for the same topic within the same instance
@@ -47,6 +60,11 @@ namespace rosbridge2cpp{
 	// will read 'Null' on msg_json_
 	ROSCallbackHandle<FunVrROSPublishMsg> Subscribe(FunVrROSPublishMsg callback);
 
+	// Selects the local receive queue for callbacks that are subscribed afterwards.
+	// With a policy other than ReceiveQueuePolicy::NONE, every callback gets its own SubscriberQueue
+	// that holds up to queue_size messages.
+	void SetReceiveQueuePolicy(ReceiveQueuePolicy policy) { receive_queue_policy_ = policy; }
+
 	// Unsubscribe from a given topic
 	// If multiple callbacks for this topic have been registered,
 	// the given callback will be unregistered in the ROSBridge WITHOUT
@@ -56,6 +74,11 @@ namespace rosbridge2cpp{
 	// AND 'unsubscribe' will be send to the server
 	bool Unsubscribe(const ROSCallbackHandle<FunVrROSPublishMsg>& callback_handle);
 
+	// Latched topics keep the last published message on the server and hand it to late subscribers.
+	// Has to be set before advertising or publishing.
+	void SetLatch(bool latch) { latch_ = latch; }
+	bool IsLatched() const { return latch_; }
+
 	// Advertise as a publisher for this topic
 	bool Advertise();
 
@@ -77,8 +100,17 @@ namespace rosbridge2cpp{
 	bool Publish(rapidjson::Value &message);
 	bool Publish(bson_t *message);
 
+	// Publish a message over this topic by writing its content directly into the outgoing rosbridge message.
+	// append_msg is called with the already started 'msg' subdocument and should append the fields of the message to it.
+	// If append_msg returns false, nothing is published.
+	// Large binary fields can be attached to the message with OutgoingMessage::AppendBinary to send them without a copy.
+	bool Publish(const FunBrBSON &append_msg);
+
 	std::string GeneratePublishID();
 
+	// Returns the local publisher queue of this topic in the ROSBridge
+	PublisherQueue& GetPublisherQueue();
+
 	std::string TopicName() {
 		return topic_name_;
 	}
@@ -94,9 +126,24 @@ namespace rosbridge2cpp{
 		int throttle_rate_ = 0;
 		bool latch_ = false;
 
-		// number of messages queued for remote publisher/subscriber within rosbridge AND local publisher queue (local subscriber queue is not supported at the moment)
+		// number of messages queued for remote publisher/subscriber within rosbridge AND local publisher and subscriber queues
 		int queue_size_ = 10;
 
+		ReceiveQueuePolicy receive_queue_policy_ = ReceiveQueuePolicy::NONE;
+
+		// local subscriber queues of the callbacks that have been subscribed with a receive queue
+		std::list<std::pair<ROSCallbackHandle<FunVrROSPublishMsg>, std::shared_ptr<SubscriberQueue>>> subscriber_queues_;
+
+		// scheduling class of this topic in the local publisher queue
+		PublisherPriority priority_ = PublisherPriority::NORMAL;
+
+		// local publisher queue in the ROSBridge, looked up on the first Publish
+		std::shared_ptr<PublisherQueue> publisher_queue_;
+		std::once_flag publisher_queue_lookup_;
+
+		// size of the last serialized message, used to allocate the next one in one go
+		std::atomic<size_t> last_message_size_{0};
+
 		// Householding variables
 		std::string advertise_id_ = "";
 		std::string subscribe_id_ = "";
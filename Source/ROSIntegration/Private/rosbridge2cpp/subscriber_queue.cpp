@@ -0,0 +1,122 @@
+#include "subscriber_queue.h"
+
+namespace rosbridge2cpp {
+
+	SubscriberQueue::SubscriberQueue(ReceiveQueuePolicy policy, int queue_size, FunVrROSPublishMsg callback)
+	: policy_(policy)
+	, queue_size_(policy == ReceiveQueuePolicy::KEEP_LATEST || queue_size < 1 ? 1 : queue_size)
+	, callback_(callback)
+	{
+	}
+
+	std::shared_ptr<SubscriberQueue> SubscriberQueue::Start(ReceiveQueuePolicy policy, int queue_size, FunVrROSPublishMsg callback)
+	{
+		std::shared_ptr<SubscriberQueue> queue(new SubscriberQueue(policy, queue_size, callback));
+		std::lock_guard<std::mutex> lock(queue->thread_mutex_);
+		queue->delivery_thread_ = std::thread(&SubscriberQueue::RunDeliveryThread, queue);
+		return queue;
+	}
+
+	void SubscriberQueue::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			run_delivery_thread_ = false;
+			for (QueuedMessage &queued : messages_) {
+				bson_destroy(queued.message);
+			}
+			messages_.clear();
+		}
+		message_queued_.notify_all();
+		message_taken_.notify_all();
+
+		std::thread delivery_thread;
+		{
+			std::lock_guard<std::mutex> lock(thread_mutex_);
+			delivery_thread.swap(delivery_thread_);
+		}
+		if (delivery_thread.joinable()) {
+			if (delivery_thread.get_id() == std::this_thread::get_id()) {
+				// the callback stops its own queue, the thread releases the queue after it has returned
+				delivery_thread.detach();
+			}
+			else {
+				delivery_thread.join();
+			}
+		}
+	}
+
+	SubscriberQueue::~SubscriberQueue()
+	{
+		// the delivery thread holds a reference until it ends, so it can only be left running without Stop()
+		if (delivery_thread_.joinable()) {
+			delivery_thread_.detach();
+		}
+		for (QueuedMessage &queued : messages_) {
+			bson_destroy(queued.message);
+		}
+	}
+
+	void SubscriberQueue::Push(const ROSBridgePublishMsg &message)
+	{
+		if (!message.full_msg_bson_) {
+			// json messages can't be copied without their document
+			callback_(message);
+			return;
+		}
+
+		QueuedMessage queued = { bson_copy(message.full_msg_bson_), message.envelope_ };
+		queued.envelope.Rebase(*message.full_msg_bson_, *queued.message);
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			if (policy_ == ReceiveQueuePolicy::BLOCK) {
+				// holds up the dispatching of further messages of this topic
+				message_taken_.wait(lock, [this] { return messages_.size() < queue_size_ || !run_delivery_thread_; });
+			}
+			if (!run_delivery_thread_) {
+				bson_destroy(queued.message);
+				return;
+			}
+			while (messages_.size() >= queue_size_) {
+				bson_destroy(messages_.front().message);
+				messages_.pop_front();
+				++num_dropped_messages_;
+			}
+			messages_.push_back(queued);
+		}
+		message_queued_.notify_one();
+	}
+
+	size_t SubscriberQueue::Size() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return messages_.size();
+	}
+
+	void SubscriberQueue::RunDeliveryThread()
+	{
+		while (true) {
+			QueuedMessage queued;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				message_queued_.wait(lock, [this] { return !messages_.empty() || !run_delivery_thread_; });
+				if (!run_delivery_thread_)
+					return;
+				queued = messages_.front();
+				messages_.pop_front();
+			}
+			message_taken_.notify_one();
+
+			// The message refers to the bson instead of owning it, like a message that has just been received.
+			// The view shares the data of the copy, so the envelope still points into it.
+			bson_t view;
+			if (bson_init_static(&view, bson_get_data(queued.message), queued.message->len)) {
+				ROSBridgePublishMsg m;
+				if (m.FromBSON(view, queued.envelope)) {
+					callback_(m);
+				}
+			}
+			bson_destroy(queued.message);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <bson.h>
+
+#include "types.h"
+
+namespace rosbridge2cpp {
+
+	// Local receive queue of a single topic subscription.
+	//
+	// Incoming messages are copied into the queue and passed to the callback on a delivery thread
+	// of this subscription, so a slow callback only delays its own messages.
+	// When the queue is full, the ReceiveQueuePolicy decides which messages are dropped.
+	//
+	// The delivery thread keeps the queue alive until it has been stopped.
+	// Stop() waits for it, so the callback isn't called anymore afterwards.
+	class SubscriberQueue {
+	public:
+		// queue_size is ignored for ReceiveQueuePolicy::KEEP_LATEST, which always keeps a single message
+		static std::shared_ptr<SubscriberQueue> Start(ReceiveQueuePolicy policy, int queue_size, FunVrROSPublishMsg callback);
+
+		// Stops the delivery thread after its current callback and waits for it.
+		// When called from the callback itself, the delivery thread ends after the callback returns.
+		// Messages that are still queued are dropped.
+		void Stop();
+
+		~SubscriberQueue();
+
+		// Called for every incoming message of the topic.
+		// Messages without BSON data are passed to the callback directly.
+		void Push(const ROSBridgePublishMsg &message);
+
+		size_t Size() const;
+		uint64_t NumDroppedMessages() const { return num_dropped_messages_; }
+
+	private:
+		SubscriberQueue(ReceiveQueuePolicy policy, int queue_size, FunVrROSPublishMsg callback);
+
+		void RunDeliveryThread();
+
+		const ReceiveQueuePolicy policy_;
+		const size_t queue_size_;
+		FunVrROSPublishMsg callback_;
+
+		std::mutex thread_mutex_; // guards delivery_thread_, which is joined by the first Stop()
+		std::thread delivery_thread_;
+
+		mutable std::mutex mutex_; // guards messages_ and run_delivery_thread_
+		std::condition_variable message_queued_;
+		std::condition_variable message_taken_;
+		struct QueuedMessage {
+			bson_t *message;
+			ROSBridgeEnvelope envelope; // points into message
+		};
+		std::deque<QueuedMessage> messages_;
+		bool run_delivery_thread_ = true;
+		std::atomic<uint64_t> num_dropped_messages_{ 0 };
+
+		SubscriberQueue(SubscriberQueue const &);
+		SubscriberQueue & operator=(SubscriberQueue const &);
+	};
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <functional>
 
 #include "rapidjson/document.h"
@@ -13,13 +14,29 @@ namespace rosbridge2cpp {
 	typedef std::function<void(const json&)> FunVcrJSON;
 	// typedef std::function<void(ROSBridgeMsg&)> FunVrROSMSG;
 	typedef std::function<void(const ROSBridgePublishMsg&)> FunVrROSPublishMsg;
+	typedef std::function<bool(bson_t&)> FunBrBSON;
 	typedef std::function<void(ROSBridgeServiceResponseMsg&)> FunVrROSServiceResponseMsg;
 	typedef std::function<void(ROSBridgeCallServiceMsg&, rapidjson::Document::AllocatorType&)> FunVrROSCallServiceMsgrROSServiceResponseMsgrAllocator;
 	typedef std::function<void(ROSBridgeCallServiceMsg&)> FunVrROSCallServiceMsgrROSServiceResponseMsg;
 	// typedef std::function<json(json&)> FunJSONcrJSON;
 
 	enum class TransportError { R2C_SOCKET_ERROR, R2C_CONNECTION_CLOSED };
-	extern unsigned long ROSCallbackHandle_id_counter;
+
+	// Scheduling class of a topic's outgoing messages.
+	// Whenever the publisher queue thread picks the next message to send,
+	// queued messages of a higher class are sent before those of lower classes.
+	// Topics of the same class are served round robin.
+	enum class PublisherPriority { BULK = 0, NORMAL = 1, CONTROL = 2 };
+	static const int NUM_PUBLISHER_PRIORITIES = 3;
+
+	// How a topic subscription buffers incoming messages (see SubscriberQueue).
+	// NONE runs the callbacks directly on the dispatcher worker of the topic.
+	// DROP_OLDEST queues up to queue_size messages and drops the oldest one when the queue is full.
+	// KEEP_LATEST only keeps the most recent message, so a slow callback always gets the freshest data.
+	// BLOCK queues up to queue_size messages and stalls the dispatching of the topic when the queue is full.
+	enum class ReceiveQueuePolicy { NONE = 0, DROP_OLDEST = 1, KEEP_LATEST = 2, BLOCK = 3 };
+	// topics subscribe from several threads
+	extern std::atomic<unsigned long> ROSCallbackHandle_id_counter;
 
 	template<typename FunctionType>
 	class ROSCallbackHandle {
@@ -29,15 +46,8 @@ namespace rosbridge2cpp {
 		, function_() {}
 
 		ROSCallbackHandle(FunctionType& function)
-		: id_(ROSCallbackHandle_id_counter)
-		, function_(function)
-		{
-			if (function_ != nullptr) {
-				ROSCallbackHandle_id_counter++;
-			} else {
-				id_ = 0;
-			}
-		}
+		: id_(function != nullptr ? ROSCallbackHandle_id_counter++ : 0)
+		, function_(function) {}
 
 		ROSCallbackHandle(const ROSCallbackHandle& other)
 		: id_(other.id_)
@@ -63,6 +73,11 @@ namespace rosbridge2cpp {
 			return function_;
 		}
 
+		const FunctionType& GetFunction() const
+		{
+			return function_;
+		}
+
 	private:
 		unsigned long id_;
 		FunctionType function_;
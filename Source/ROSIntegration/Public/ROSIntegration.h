@@ -31,4 +31,7 @@ public:
 	{
 		return FModuleManager::Get().IsModuleLoaded("ROSIntegration");
 	}
+
+private:
+	FDelegateHandle ModulesChangedHandle;
 };
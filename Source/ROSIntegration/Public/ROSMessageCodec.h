@@ -0,0 +1,54 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <bson.h>
+
+#include "std_msgs/String.h"
+#include "std_msgs/Float32.h"
+#include "geometry_msgs/Twist.h"
+#include "geometry_msgs/PoseStamped.h"
+#include "sensor_msgs/Imu.h"
+#include "nav_msgs/Odometry.h"
+#include "nav_msgs/OccupancyGrid.h"
+#include "tf2_msgs/TFMessage.h"
+#include "rosgraph_msgs/Clock.h"
+
+class ROSBridgePublishMsg;
+class FBSONTemplateWriter;
+
+/**
+ * Encoding of a message type that is selected at compile time, see TTypedTopic.
+ * Only the types declared with DECLARE_ROS_MESSAGE_CODEC have a codec, other types don't compile.
+ * The codecs are defined next to the converters of their types, which use them for the TSharedPtr<FROSBaseMsg> interface:
+ *
+ *	MessageType()         the ROS type name, e.g. "sensor_msgs/Imu"
+ *	Decode()              decodes the 'msg' field of an incoming message into Msg, reusing the memory of its arrays.
+ *	                      Options of the message, e.g. OccupancyGrid::int8_storage, are kept.
+ *	Append()              appends the fields of Msg to the 'msg' field of an outgoing message
+ *	WriteTemplateValues() writes the values of messages with a fixed layout, see FBSONMessageTemplate.
+ *	                      Returns false for other types.
+ *	bSupportsTemplate     true for the types with a fixed layout, the others are appended directly without a template
+ */
+template<class MsgT>
+struct TROSMessageCodec;
+
+#define DECLARE_ROS_MESSAGE_CODEC(MsgT, Type, bFixedLayout) \
+	template<> \
+	struct ROSINTEGRATION_API TROSMessageCodec<MsgT> \
+	{ \
+		static constexpr bool bSupportsTemplate = bFixedLayout; \
+		static const TCHAR* MessageType() { return TEXT(Type); } \
+		static bool Decode(const ROSBridgePublishMsg& message, MsgT& Msg); \
+		static bool Append(const MsgT& Msg, bson_t* message); \
+		static bool WriteTemplateValues(const MsgT& Msg, FBSONTemplateWriter& Writer); \
+	};
+
+DECLARE_ROS_MESSAGE_CODEC(ROSMessages::std_msgs::String, "std_msgs/String", false)
+DECLARE_ROS_MESSAGE_CODEC(ROSMessages::std_msgs::Float32, "std_msgs/Float32", true)
+DECLARE_ROS_MESSAGE_CODEC(ROSMessages::geometry_msgs::Twist, "geometry_msgs/Twist", true)
+DECLARE_ROS_MESSAGE_CODEC(ROSMessages::geometry_msgs::PoseStamped, "geometry_msgs/PoseStamped", true)
+DECLARE_ROS_MESSAGE_CODEC(ROSMessages::sensor_msgs::Imu, "sensor_msgs/Imu", true)
+DECLARE_ROS_MESSAGE_CODEC(ROSMessages::nav_msgs::Odometry, "nav_msgs/Odometry", true)
+DECLARE_ROS_MESSAGE_CODEC(ROSMessages::nav_msgs::OccupancyGrid, "nav_msgs/OccupancyGrid", false)
+DECLARE_ROS_MESSAGE_CODEC(ROSMessages::tf2_msgs::TFMessage, "tf2_msgs/TFMessage", false)
+DECLARE_ROS_MESSAGE_CODEC(ROSMessages::rosgraph_msgs::Clock, "rosgraph_msgs/Clock", true)
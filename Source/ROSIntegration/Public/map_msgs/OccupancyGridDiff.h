@@ -0,0 +1,215 @@
+#pragma once
+
+#include "map_msgs/OccupancyGridUpdate.h"
+
+namespace ROSMessages {
+	namespace map_msgs {
+		/**
+		 * Diffs occupancy grids against the last published one, so only the changed rectangles
+		 * have to be sent as OccupancyGridUpdate, e.g. on "map_updates" next to "map":
+		 *
+		 *	TArray<TSharedPtr<ROSMessages::map_msgs::OccupancyGridUpdate>> Updates;
+		 *	if (!MapDiff.Diff(*Grid, Updates)) {
+		 *		MapTopic->Publish(Grid);
+		 *	}
+		 *	for (auto& Update : Updates) {
+		 *		MapUpdatesTopic->Publish(Update);
+		 *	}
+		 *
+		 * Subscribers patch their copy of the map with OccupancyGridUpdate::ApplyTo.
+		 */
+		class OccupancyGridDiff {
+		public:
+			// Changed cells are collected in tiles of TileSize x TileSize cells, adjacent tiles are merged into rectangles
+			explicit OccupancyGridDiff(int32 TileSize = 32) : TileSize(TileSize > 0 ? TileSize : 1) {}
+
+			// Returns false if Grid has to be published in full, because there is no previous grid, its geometry changed
+			// or the changes cover more than half of it. Otherwise Updates receives an update per changed rectangle,
+			// none if nothing changed. Grid becomes the last published grid in both cases.
+			bool Diff(const nav_msgs::OccupancyGrid& Grid, TArray<TSharedPtr<OccupancyGridUpdate>>& Updates)
+			{
+				Updates.Reset();
+
+				const int32 Width = Grid.info.width;
+				const int32 Height = Grid.info.height;
+				if (Grid.NumCells() != Width * Height) {
+					Reset();
+					return false;
+				}
+
+				const int8* Current = Grid.data_int8.GetData();
+				if (!Grid.int8_storage) {
+					Scratch.SetNumUninitialized(Grid.data.Num());
+					for (int32 i = 0; i < Grid.data.Num(); ++i) {
+						Scratch[i] = (int8)Grid.data[i];
+					}
+					Current = Scratch.GetData();
+				}
+
+				const bool bSameGeometry = bHasGrid && HasSameGeometry(Grid.info);
+				Info = Grid.info;
+				bHasGrid = true;
+				if (!bSameGeometry) {
+					Store(Current, Width * Height);
+					return false;
+				}
+
+				TArray<FRect> Rects;
+				CollectChangedRects(Current, Width, Height, Rects);
+
+				int64 ChangedArea = 0;
+				for (const FRect& Rect : Rects) {
+					ChangedArea += (int64)Rect.Width() * Rect.Height();
+				}
+				if (ChangedArea * 2 > (int64)Width * Height) {
+					Store(Current, Width * Height);
+					return false;
+				}
+
+				for (const FRect& Rect : Rects) {
+					TSharedPtr<OccupancyGridUpdate> Update(new OccupancyGridUpdate());
+					Update->header = Grid.header;
+					Update->x = Rect.MinX;
+					Update->y = Rect.MinY;
+					Update->width = Rect.Width();
+					Update->height = Rect.Height();
+					Update->data.SetNumUninitialized(Rect.Width() * Rect.Height());
+					for (int32 Row = 0; Row < Rect.Height(); ++Row) {
+						FMemory::Memcpy(Update->data.GetData() + Row * Rect.Width(), Current + (Rect.MinY + Row) * Width + Rect.MinX, Rect.Width());
+					}
+					Updates.Add(Update);
+				}
+
+				Store(Current, Width * Height);
+				return true;
+			}
+
+			// Forgets the last published grid, so the next one is published in full, e.g. after reconnecting
+			void Reset()
+			{
+				Cells.Empty();
+				bHasGrid = false;
+			}
+
+		private:
+			// Inclusive bounds of changed cells
+			struct FRect
+			{
+				int32 MinX = MAX_int32;
+				int32 MinY = MAX_int32;
+				int32 MaxX = -1;
+				int32 MaxY = -1;
+
+				bool IsEmpty() const { return MaxX < MinX; }
+				int32 Width() const { return MaxX - MinX + 1; }
+				int32 Height() const { return MaxY - MinY + 1; }
+
+				void Add(const FRect& Other)
+				{
+					MinX = FMath::Min(MinX, Other.MinX);
+					MinY = FMath::Min(MinY, Other.MinY);
+					MaxX = FMath::Max(MaxX, Other.MaxX);
+					MaxY = FMath::Max(MaxY, Other.MaxY);
+				}
+			};
+
+			// Dirty tiles [FirstTile, LastTile] of a row of tiles
+			struct FRun
+			{
+				int32 FirstTile;
+				int32 LastTile;
+				FRect Rect;
+			};
+
+			bool HasSameGeometry(const nav_msgs::MapMetaData& Other) const
+			{
+				const geometry_msgs::Pose& A = Info.origin;
+				const geometry_msgs::Pose& B = Other.origin;
+				return Info.width == Other.width && Info.height == Other.height && Info.resolution == Other.resolution &&
+					A.position.x == B.position.x && A.position.y == B.position.y && A.position.z == B.position.z &&
+					A.orientation.x == B.orientation.x && A.orientation.y == B.orientation.y &&
+					A.orientation.z == B.orientation.z && A.orientation.w == B.orientation.w;
+			}
+
+			void CollectChangedRects(const int8* Current, int32 Width, int32 Height, TArray<FRect>& Rects) const
+			{
+				const int32 TilesX = (Width + TileSize - 1) / TileSize;
+				const int32 TilesY = (Height + TileSize - 1) / TileSize;
+
+				// bounds of the changed cells in every tile, unchanged rows and tiles are skipped with memcmp
+				TArray<FRect> Tiles;
+				Tiles.Init(FRect(), TilesX * TilesY);
+				for (int32 Y = 0; Y < Height; ++Y) {
+					const int8* Row = Current + Y * Width;
+					const int8* LastRow = Cells.GetData() + Y * Width;
+					if (FMemory::Memcmp(Row, LastRow, Width) == 0) continue;
+
+					for (int32 TileX = 0; TileX < TilesX; ++TileX) {
+						const int32 First = TileX * TileSize;
+						const int32 End = FMath::Min(First + TileSize, Width);
+						if (FMemory::Memcmp(Row + First, LastRow + First, End - First) == 0) continue;
+
+						FRect Changed;
+						for (int32 X = First; X < End; ++X) {
+							if (Row[X] != LastRow[X]) {
+								Changed.MinX = FMath::Min(Changed.MinX, X);
+								Changed.MaxX = X;
+							}
+						}
+						Changed.MinY = Changed.MaxY = Y;
+						Tiles[(Y / TileSize) * TilesX + TileX].Add(Changed);
+					}
+				}
+
+				// adjacent dirty tiles of a row become a run, runs over the same tiles of consecutive rows are merged
+				TArray<FRun> Open, Next;
+				for (int32 TileY = 0; TileY < TilesY; ++TileY) {
+					Next.Reset();
+					for (int32 TileX = 0; TileX < TilesX; ++TileX) {
+						const FRect& Tile = Tiles[TileY * TilesX + TileX];
+						if (Tile.IsEmpty()) continue;
+
+						if (Next.Num() > 0 && Next.Last().LastTile == TileX - 1) {
+							Next.Last().LastTile = TileX;
+							Next.Last().Rect.Add(Tile);
+						}
+						else {
+							Next.Add({ TileX, TileX, Tile });
+						}
+					}
+
+					for (FRun& Run : Next) {
+						for (int32 i = 0; i < Open.Num(); ++i) {
+							if (Open[i].FirstTile == Run.FirstTile && Open[i].LastTile == Run.LastTile) {
+								Run.Rect.Add(Open[i].Rect);
+								Open.RemoveAt(i);
+								break;
+							}
+						}
+					}
+					for (const FRun& Run : Open) {
+						Rects.Add(Run.Rect);
+					}
+					Swap(Open, Next);
+				}
+				for (const FRun& Run : Open) {
+					Rects.Add(Run.Rect);
+				}
+			}
+
+			void Store(const int8* Current, int32 Num)
+			{
+				if (Current != Cells.GetData()) {
+					Cells.SetNumUninitialized(Num);
+					FMemory::Memcpy(Cells.GetData(), Current, Num);
+				}
+			}
+
+			const int32 TileSize;
+			bool bHasGrid = false;
+			nav_msgs::MapMetaData Info;
+			TArray<int8> Cells;   // cells of the last published grid
+			TArray<int8> Scratch; // int8 copy of grids with int32 storage
+		};
+	}
+}
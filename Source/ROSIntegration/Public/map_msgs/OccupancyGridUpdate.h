@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ROSBaseMsg.h"
+
+#include "std_msgs/Header.h"
+#include "nav_msgs/OccupancyGrid.h"
+
+namespace ROSMessages {
+	namespace map_msgs {
+		class OccupancyGridUpdate : public FROSBaseMsg {
+		public:
+			OccupancyGridUpdate() {
+				_MessageType = "map_msgs/OccupancyGridUpdate";
+			}
+
+			// Header header
+			std_msgs::Header header;
+
+			// int32 x
+			int32 x = 0;
+
+			// int32 y
+			int32 y = 0;
+
+			// uint32 width
+			uint32 width = 0;
+
+			// uint32 height
+			uint32 height = 0;
+
+			// int8[] data, the cells of the rectangle in row-major order
+			TArray<int8> data;
+
+			// Copies the cells of the update into Grid, in either storage of the grid.
+			// Returns false and leaves Grid unchanged if the rectangle doesn't lie within it.
+			bool ApplyTo(nav_msgs::OccupancyGrid& Grid) const
+			{
+				const int64 GridWidth = Grid.info.width;
+				const int64 GridHeight = Grid.info.height;
+				if (x < 0 || y < 0 || x + (int64)width > GridWidth || y + (int64)height > GridHeight ||
+					(int64)data.Num() != (int64)width * height || Grid.NumCells() != GridWidth * GridHeight) {
+					return false;
+				}
+
+				for (uint32 Row = 0; Row < height; ++Row) {
+					const int8* Source = data.GetData() + Row * width;
+					const int32 Target = (y + Row) * GridWidth + x;
+					if (Grid.int8_storage) {
+						FMemory::Memcpy(Grid.data_int8.GetData() + Target, Source, width);
+					}
+					else {
+						for (uint32 Column = 0; Column < width; ++Column) {
+							Grid.data[Target + Column] = Source[Column];
+						}
+					}
+				}
+				return true;
+			}
+		};
+	}
+}
@@ -22,6 +22,36 @@ namespace ROSMessages {
 			// int8[] data
 			// Note: BSON will coerce the int32 to int8. int8 not implemented in BSON.
 			TArray<int32> data;
+
+			// Alternatively, hold the cells as int8, which takes a quarter of the memory (data is ignored then).
+			// Incoming grids keep the storage of the instance they are decoded into, so the converter fills data.
+			// A TTypedTopic<OccupancyGrid> subscription with an int8_storage prototype fills data_int8 instead.
+			bool int8_storage = false;
+			TArray<int8> data_int8;
+
+			// Cell access that works with either storage
+			int32 NumCells() const
+			{
+				return int8_storage ? data_int8.Num() : data.Num();
+			}
+
+			int8 GetCell(int32 Index) const
+			{
+				return int8_storage ? data_int8[Index] : (int8)data[Index];
+			}
+
+			// Moves the cells from data to data_int8
+			void ConvertToInt8Storage()
+			{
+				if (int8_storage) return;
+
+				data_int8.SetNumUninitialized(data.Num());
+				for (int32 i = 0; i < data.Num(); ++i) {
+					data_int8[i] = (int8)data[i];
+				}
+				data.Empty();
+				int8_storage = true;
+			}
 		};
 	}
 }
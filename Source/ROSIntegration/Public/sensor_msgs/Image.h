@@ -38,6 +38,12 @@ namespace ROSMessages {
 			// hand over a pointer to the uint8 data.
 			// Please note, that the memory this pointer points to must be valid until this message has been published.
 			const uint8* data;		// actual matrix data, size is (step * rows)
+
+			// Alternatively, hand over the image data in a shared buffer (data is ignored then).
+			// The buffer is sent without copying it and released as soon as it has been written to the socket.
+			// Please note, that the buffer must not be modified after publishing the message.
+			// Publishing fails if it holds less than step * height bytes.
+			TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> data_buffer;
 		};
 	}
 }